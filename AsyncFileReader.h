@@ -0,0 +1,301 @@
+
+#ifndef ASYNC_FILE_READER_H
+#define ASYNC_FILE_READER_H
+
+#include "BufferedReader.h"
+#include "IoUring.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * @brief This class reads *lines* from a regular file, in large *blocks* -
+ *        while the reads of the next blocks are already in flight.
+ *
+ * The file is read into `blockCount` buffers in turn - block `i` into
+ * buffer `i % blockCount`. The reads of the first blocks are all submitted
+ * at once to an `IoUring`, and once all the lines of a block were gotten,
+ * its buffer is submitted again - to read the block that is `blockCount`
+ * blocks after it. So the lines of block `i` are parsed while the blocks
+ * after it are read by the kernel (or by the device) - and a cold file is
+ * read at the speed of the device, rather than one block at a time.
+ *
+ * A kernel that does not allow *io_uring* is not an error: in that case, the
+ * blocks are read one by one with `pread`, and only the read-ahead of the
+ * kernel overlaps them (see @link isAsynchronous @endlink).
+ *
+ * The lines are returned the same way as by a `BufferedReader`:
+ * @code
+ * AsyncFileReader reader("commands.txt");
+ * std::string_view line;
+ * if (reader.isRegularFile()) {
+ *     while (reader.getLine(line)) { std::cout << line << std::endl; }
+ * }
+ * @endcode
+ *
+ * A file that is *not* a regular file (for example, a pipe) has no blocks to
+ * read ahead. In that case, @link isRegularFile @endlink returns `false`,
+ * and the file should be read via its @link getFd @endlink instead.
+ *
+ * @attention a line returned is valid *only* until the next call to
+ *            @link getLine @endlink.
+ * @see MappedFile
+ * @version 1.0
+ */
+class AsyncFileReader : public BufferedReader {
+
+  public:
+    /// The default size of a block read, in bytes.
+    static constexpr unsigned long DEFAULT_BLOCK_SIZE = 1UL << 20;
+
+  public:
+    /// The default amount of blocks read at once.
+    static constexpr unsigned long DEFAULT_BLOCK_COUNT = 4;
+
+  protected:
+    static constexpr char *OPEN_ERROR_MESSAGE =
+            (char *) "AsyncFileReader: failed to open the file.";
+
+  protected:
+    static constexpr char *READ_ERROR_MESSAGE =
+            (char *) "AsyncFileReader: failed to read from the file.";
+
+  protected:
+    static constexpr char *BLOCK_MESSAGE = (char *) "AsyncFileReader: "
+                                                    "`blockSize` and "
+                                                    "`blockCount` must be at "
+                                                    "least `1`.";
+
+  protected:
+    /// A buffer, that a single block is read into.
+    struct Block {
+
+        std::unique_ptr<char[]> data;
+
+        /// Points to the `data` - for the read of the `IoUring`.
+        iovec vector {};
+
+        /// The amount of bytes the read of the block returned, or a negative
+        /// `errno` value.
+        long result = 0;
+
+        /// Whether the read of the block was submitted, and not reaped yet.
+        bool isInFlight = false;
+    };
+
+  protected:
+    /// The file-descriptor of the file. Owned by `this` reader.
+    int _fileFd = -1;
+
+  protected:
+    bool _isRegularFile = false;
+
+  protected:
+    unsigned long _fileSize = 0;
+
+  protected:
+    unsigned long _blockSize = 0;
+
+  protected:
+    std::unique_ptr<Block[]> _blocks;
+
+  protected:
+    unsigned long _blockCount = 0;
+
+  protected:
+    /// The index of the next block to get lines from.
+    unsigned long _nextBlock = 0;
+
+  protected:
+    IoUring _ring;
+
+  public:
+    /**
+     * @param path the path of the file to read.
+     * @param blockSize the size of each block read, in bytes.
+     * @param blockCount the amount of blocks read at once.
+     * @throws std::runtime_error in case the file could not be opened.
+     */
+    explicit AsyncFileReader(const std::string &path,
+                             unsigned long      blockSize = DEFAULT_BLOCK_SIZE,
+                             unsigned long blockCount = DEFAULT_BLOCK_COUNT)
+        : _blockSize(blockSize), _blockCount(blockCount),
+          _ring((unsigned) blockCount) {
+        if ((blockSize < 1) || (blockCount < 1)) {
+            throw std::invalid_argument(BLOCK_MESSAGE);
+        }
+
+        _fileFd = ::open(path.c_str(), O_RDONLY);
+        if (_fileFd < 0) { throw std::runtime_error(OPEN_ERROR_MESSAGE); }
+
+        struct stat fileStatus {};
+        if ((::fstat(_fileFd, &fileStatus) != 0) ||
+            !S_ISREG(fileStatus.st_mode)) {
+            return;
+        }
+        _isRegularFile = true;
+        _fileSize      = (unsigned long) fileStatus.st_size;
+
+        // The file is read from its start to its end, only once.
+        ::posix_fadvise(_fileFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        // Without the ring, a single buffer is enough.
+        if (!_ring.isAvailable()) { _blockCount = 1; }
+        _blocks = std::unique_ptr<Block[]>(new Block[_blockCount]);
+        for (unsigned long i = 0; i < _blockCount; i++) {
+            _blocks[i].data = std::unique_ptr<char[]>(new char[_blockSize]);
+            _blocks[i].vector.iov_base = _blocks[i].data.get();
+        }
+
+        if (_ring.isAvailable()) {
+            for (unsigned long i = 0; i < _blockCount; i++) { submitBlock(i); }
+            _ring.submit();
+        }
+    }
+
+  public:
+    AsyncFileReader(const AsyncFileReader &other) = delete;
+
+  public:
+    AsyncFileReader &operator=(const AsyncFileReader &other) = delete;
+
+  public:
+    ~AsyncFileReader() override {
+
+        // The kernel must not write into the buffers after they are freed.
+        try {
+            for (unsigned long i = 0; i < _blockCount; i++) {
+                if (_blocks != nullptr) { reapBlock(_blocks[i]); }
+            }
+        } catch (std::exception &e) {}
+        if (_fileFd >= 0) { ::close(_fileFd); }
+    }
+
+  public:
+    /// @return `true` if the file is a regular file, that is read in blocks.
+    bool isRegularFile() const { return _isRegularFile; }
+
+  public:
+    /// @return `true` if the blocks are read ahead through an `IoUring`.
+    ///         `false` if they are read one by one with `pread`.
+    bool isAsynchronous() const { return _ring.isAvailable(); }
+
+  public:
+    /// @return the file-descriptor of the file. Owned by `this` reader.
+    int getFd() const { return _fileFd; }
+
+  protected:
+    /**
+     * @brief Gets the next block of the file - and submits the read of the
+     *        block `blockCount` blocks after the previous one, into the
+     *        buffer of the previous one.
+     */
+    bool fillBuffer() override {
+        if (_isEndOfInput || !_isRegularFile) {
+            _isEndOfInput = true;
+            return false;
+        }
+
+        if (_ring.isAvailable() && (_nextBlock > 0)) {
+            submitBlock(_nextBlock - 1 + _blockCount);
+            _ring.submit();
+        }
+
+        unsigned long offset = _nextBlock * _blockSize;
+        if (offset >= _fileSize) {
+            _isEndOfInput = true;
+            return false;
+        }
+        Block &       block  = _blocks[_nextBlock % _blockCount];
+        unsigned long length = std::min(_blockSize, _fileSize - offset);
+        if (_ring.isAvailable()) {
+            reapBlock(block);
+        } else {
+            block.result = 0;
+        }
+        if (block.result < 0) { throw std::runtime_error(READ_ERROR_MESSAGE); }
+
+        // A short read (or a synchronous one) is completed with `pread`.
+        block.result += readFully(block.data.get() + block.result,
+                                  length - block.result,
+                                  offset + block.result);
+
+        _position = block.data.get();
+        _end      = block.data.get() + block.result;
+        _nextBlock++;
+
+        _bytesRead += block.result;
+        if (block.result == 0) { _isEndOfInput = true; }
+        return block.result > 0;
+    }
+
+  protected:
+    /// @brief Submits the read of the given @p blockIndex - if it is within
+    ///        the file - into its buffer.
+    void submitBlock(unsigned long blockIndex) {
+        unsigned long offset = blockIndex * _blockSize;
+        if (offset >= _fileSize) { return; }
+
+        Block &block         = _blocks[blockIndex % _blockCount];
+        block.result         = 0;
+        block.vector.iov_len = std::min(_blockSize, _fileSize - offset);
+        block.isInFlight     = true;
+        _ring.prepareRead(_fileFd, &block.vector, offset,
+                          blockIndex % _blockCount);
+    }
+
+  protected:
+    /**
+     * @brief Waits until the read of the given @p block completes - reaping
+     *        the reads of the other blocks that complete before it.
+     */
+    void reapBlock(Block &block) {
+        while (block.isInFlight) {
+            std::uint64_t userData = 0;
+            int           result   = 0;
+            _ring.waitForCompletion(userData, result);
+
+            Block &completed     = _blocks[userData];
+            completed.result     = result;
+            completed.isInFlight = false;
+
+            // An interrupted read is read again with `pread`.
+            if ((result == -EINTR) || (result == -EAGAIN)) {
+                completed.result = 0;
+            }
+        }
+    }
+
+  protected:
+    /**
+     * @brief Reads the given @p length bytes at the given @p offset of the
+     *        file - or until the end of the file.
+     * @return the amount of bytes read.
+     * @throws std::runtime_error in case reading from the file failed.
+     */
+    unsigned long readFully(char *data, unsigned long length,
+                            unsigned long offset) {
+        unsigned long total = 0;
+        while (total < length) {
+            long bytesRead = (long) ::pread(_fileFd, data + total,
+                                            length - total,
+                                            (off_t) (offset + total));
+            if ((bytesRead < 0) && (errno == EINTR)) { continue; }
+            if (bytesRead < 0) {
+                throw std::runtime_error(READ_ERROR_MESSAGE);
+            }
+            if (bytesRead == 0) { break; }
+            total += bytesRead;
+        }
+        return total;
+    }
+};
+
+#endif // ASYNC_FILE_READER_H
@@ -2,10 +2,15 @@
 #ifndef BASE_ARRAY_H
 #define BASE_ARRAY_H
 
+#include "BasicAlgorithms.h"
+#include "BasicAllocations.h"
 #include "Object.h"
-#include "Unique.h"
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * @brief This class wraps an array of a *constant size*, and `delete`s it on
@@ -46,14 +51,51 @@
  *           delete str;
  * @endcode
  *
+ * The elements are stored *by value* in a single contiguous buffer. Arrays
+ * of up to `INLINE_CAPACITY` elements are stored *within* `this` object
+ * itself, so creating them does not allocate at all.
+ *
  * @note DEVELOPER NOTE: You must ensure that the `BaseArray<E>::_physicalSize`
  *       is larger than the logical-`size` by `1` at all times.
- * @tparam E the type of `element` in the array.
+ * @tparam E the type of `element` in the array. **Must** be
+ *           default-constructible.
+ * @tparam Allocator a std-allocator compatible allocator, that arrays larger
+ *                   than `INLINE_CAPACITY` are allocated with.
  *
- * @see Unique
- * @version 1.0.6
+ * @version 2.0.0
  */
-template<typename E> class BaseArray : public Object {
+template<typename E, typename Allocator = std::allocator<E>>
+class BaseArray : public Object {
+
+  public:
+    /**
+     * @brief The type of a `BaseArray` of `E2` elements, that allocates
+     *        with `this` array's `Allocator` - rebound to `E2`.
+     * @see map
+     */
+    template<typename E2>
+    using Rebind = BaseArray<E2, BasicAllocations::Rebind<E2, Allocator>>;
+
+  public:
+    template<typename E2, typename Allocator2> friend class BaseArray;
+
+  public:
+    /**
+     * @brief Whether a callable of type `Function` that is invoked with an
+     *        `E *`, returns an `E2 *` - rather than an `E2` *by value*.
+     * @see map
+     */
+    template<typename Function, typename E2>
+    using IsPointerMapFunction = std::is_same<
+            decltype(std::declval<Function &>()(std::declval<E *>())), E2 *>;
+
+  public:
+    /**
+     * The maximum amount of elements that are stored *within* `this` object,
+     * without allocating a buffer. Enough for splitting a whole command of
+     * the program.
+     */
+    static constexpr unsigned long INLINE_CAPACITY = 4;
 
   protected:
     static constexpr char *PHYSICAL_SIZE_MESSAGE =
@@ -72,29 +114,44 @@ template<typename E> class BaseArray : public Object {
             (char *) "BaseArray: Element is `nullptr`.";
 
   protected:
-    Unique<E> **_array = nullptr;
+    /// The storage of the elements, when they fit in `INLINE_CAPACITY`.
+    typename std::aligned_storage<sizeof(E), alignof(E)>::type
+            _inlineElements[INLINE_CAPACITY];
+
+  protected:
+    /**
+     * Points to the first element - either within the `_inlineElements`, or
+     * within a buffer allocated with the `_allocator`.
+     */
+    E *_array = nullptr;
+
+  protected:
+    /// The allocator that the buffer is allocated with.
+    Allocator _allocator;
 
   protected:
     /// *Must* be `0` for `move` operation.
     unsigned long _physicalSize = 0;
 
+  protected:
+    /// The amount of elements the buffer of the `_array` can hold.
+    unsigned long _capacity = 0;
+
   public:
     unsigned long size() const { return _physicalSize; }
 
   public:
-    explicit BaseArray(unsigned long physicalSize) {
+    explicit BaseArray(unsigned long    physicalSize,
+                       const Allocator &allocator = Allocator())
+        : _allocator(allocator) {
         if (physicalSize < 1) {
             throw std::invalid_argument(PHYSICAL_SIZE_MESSAGE);
         }
-        _physicalSize = physicalSize;
-        _array        = new Unique<E> *[_physicalSize];
-        initUniqueArray(_array, _physicalSize);
-    }
-
-  protected:
-    static void initUniqueArray(Unique<E> **&array, unsigned long size) {
-        for (unsigned long i = 0; i < size; i++) {
-            array[i] = new Unique<E>(nullptr);
+        _array    = allocateBuffer(physicalSize);
+        _capacity = physicalSize;
+        for (; _physicalSize < physicalSize; _physicalSize++) {
+            std::allocator_traits<Allocator>::construct(
+                    _allocator, &_array[_physicalSize]);
         }
     }
 
@@ -102,18 +159,57 @@ template<typename E> class BaseArray : public Object {
     BaseArray(const BaseArray &other) = delete;
 
   public:
-    BaseArray(BaseArray &&other) noexcept { *this = std::move(other); }
+    BaseArray(BaseArray &&other) noexcept : _allocator(other._allocator) {
+        *this = std::move(other);
+    }
 
   public:
     virtual ~BaseArray() { deleteThis(); }
 
   protected:
-    void deleteThis() { deleteUniqueArray(_array, _physicalSize); }
+    void deleteThis() {
+        destroyElements(_array, _physicalSize);
+        deallocateBuffer(_array, _capacity);
+        _array        = nullptr;
+        _physicalSize = 0;
+        _capacity     = 0;
+    }
 
   protected:
-    static void deleteUniqueArray(Unique<E> **&array, unsigned long size) {
-        for (unsigned long i = 0; i < size; i++) { delete array[i]; }
-        delete[] array;
+    /**
+     * @return a buffer that can hold @p capacity elements - which is the
+     *         `_inlineElements` when they are large enough.
+     *         The elements in the buffer are *not* constructed.
+     */
+    E *allocateBuffer(unsigned long capacity) {
+        if (capacity <= INLINE_CAPACITY) {
+            return reinterpret_cast<E *>(_inlineElements);
+        }
+        return std::allocator_traits<Allocator>::allocate(_allocator, capacity);
+    }
+
+  protected:
+    /**
+     * @brief Deallocates a buffer allocated by the @link allocateBuffer
+     *        @endlink method. The elements in the buffer must be destructed
+     *        beforehand.
+     */
+    void deallocateBuffer(E *buffer, unsigned long capacity) {
+        if ((buffer == nullptr) || isInlineBuffer(buffer)) { return; }
+        std::allocator_traits<Allocator>::deallocate(_allocator, buffer,
+                                                     capacity);
+    }
+
+  protected:
+    bool isInlineBuffer(E *buffer) const {
+        return buffer == reinterpret_cast<const E *>(_inlineElements);
+    }
+
+  protected:
+    void destroyElements(E *elements, unsigned long size) {
+        for (unsigned long i = 0; i < size; i++) {
+            std::allocator_traits<Allocator>::destroy(_allocator, &elements[i]);
+        }
     }
 
   public:
@@ -122,12 +218,15 @@ template<typename E> class BaseArray : public Object {
             throw std::out_of_range(OUT_OF_RANGE_MESSAGE);
         }
 
-        E *element = _array[index]->getElement(); // Shallow copy pointer.
-        return *element;
+        return _array[index];
     }
 
   public:
     /**
+     * @brief Copies the given @p element to the @p index in the array.
+     *
+     * @param element the element to copy. In case it is `nullptr`, the
+     *                element in the @p index is reset to a default `E`.
      * @param isAnonymous in case the element as an "inline anonymous heap
      *                    allocated lvalue" then, you should set the
      *                    @p isAnonymous to `true`. And that way, `this` array
@@ -138,13 +237,14 @@ template<typename E> class BaseArray : public Object {
             throw std::out_of_range(OUT_OF_RANGE_MESSAGE);
         }
 
-        auto *unique = new Unique<E>(element);
-        if (isAnonymous) { unique->setNeedToDeleteElement(true); }
-
-        // Delete old element.
-        delete this->_array[index];
-
-        this->_array[index] = unique;
+        if (element == nullptr) {
+            _array[index] = E();
+        } else if (isAnonymous) {
+            _array[index] = (E &&) *element;
+            delete element;
+        } else {
+            _array[index] = *element;
+        }
     }
 
   public:
@@ -153,23 +253,15 @@ template<typename E> class BaseArray : public Object {
             throw std::out_of_range(OUT_OF_RANGE_MESSAGE);
         }
 
-        auto *unique = new Unique<E>((E &&) element);
-
-        // Delete old element.
-        delete this->_array[index];
-
-        this->_array[index] = unique;
+        _array[index] = (E &&) element;
     }
 
   public:
-    virtual E *deleteElement(unsigned long index) {
-        Unique<E> *uniqueDeleted  = _array[index];
-        E *        elementDeleted = uniqueDeleted->getElement();
-        if (!uniqueDeleted->isNeedToDeleteElement()) {
-            uniqueDeleted = nullptr;
-        }
-        return elementDeleted;
-    }
+    /**
+     * @return a pointer to the element in the given @p index, that remains
+     *         owned by `this` array.
+     */
+    virtual E *deleteElement(unsigned long index) { return &_array[index]; }
 
   public:
     /**
@@ -221,13 +313,13 @@ template<typename E> class BaseArray : public Object {
      *                        for you to use this method.
      * @return `this` object. So that you may "chain" this method with another.
      */
-    virtual BaseArray<E> &forEach(const std::function<void(E *)> &callBack,
-                                  unsigned long sizeToIterateOnTo = 0) {
+    virtual BaseArray &forEach(const std::function<void(E *)> &callBack,
+                               unsigned long sizeToIterateOnTo = 0) {
         unsigned long sizeToIterateOnToDynamic =
                 getSizeToIterateOnToDynamic(sizeToIterateOnTo);
 
         for (unsigned long i = 0; i < sizeToIterateOnToDynamic; i++) {
-            callBack(this->_array[i]->getElement());
+            callBack(&this->_array[i]);
         }
 
         return *this;
@@ -239,22 +331,27 @@ template<typename E> class BaseArray : public Object {
      *        do not return `true` the given @p predicate function.
      *
      * @note in case all of the array got filtered out, then this method will
-     *       return an array of physicalSize of `1` with `nullptr` as its
+     *       return an array of physicalSize of `1` with a default `E` as its
      *       first element.
+     * @note The elements that remain are *moved* to the front of the array,
+     *       without any reallocation.
      *
      * For example:
      * @code
      * BaseArray<std::string> baseArray(3);
+     * baseArray.setElement("32", 0);
+     * baseArray.setElement("455", 1);
+     * baseArray.setElement("7678", 2);
      * std::cout << baseArray << std::endl;
-     * baseArray.filter([&baseArray](auto *s) { return s != nullptr; });
+     * baseArray.filter([&baseArray](auto *s) { return s->length() > 2; });
      * // You may also use the explicit option of:
-     * // baseArray.filter([&baseArray](std::string *s) { return s != nullptr; });
+     * // baseArray.filter([&baseArray](std::string *s) { return s->length() > 2; });
      * std::cout << baseArray << std::endl;
      * @endcode
      * will result with the output of:
      * @code
-     * [nullptr ,nullptr ,nullptr]
-     * [nullptr]
+     * [32 ,455 ,7678]
+     * [455 ,7678]
      * @endcode
      *
      * @param predicate a `bool` function such that only the elements that
@@ -266,81 +363,20 @@ template<typename E> class BaseArray : public Object {
      *                        for you to use this method.
      * @return `this` object. So that you may "chain" this method with another.
      */
-    virtual BaseArray<E> &filter(const std::function<bool(E *)> &predicate,
-                                 unsigned long sizeToIterateOnTo = 0) {
+    virtual BaseArray &filter(const std::function<bool(E *)> &predicate,
+                              unsigned long sizeToIterateOnTo = 0) {
         unsigned long sizeToIterateOnToDynamic =
                 getSizeToIterateOnToDynamic(sizeToIterateOnTo);
 
-        unsigned long newArrayPhysicalSize = 0;
-
         /*
-         * Must iterate over the array twice.
-         * The `for-loops`' content is:
-         * 1. Count the `newArraySize`.
-         * 2. - `insert` the elements that are `true` with the predicate
-         *      given to `newArray`.
+         * Must iterate over the array once.
+         * *Move* the elements that are `true` with the predicate given,
+         * to the front of the array.
          */
-        for (unsigned long i = 0; i < sizeToIterateOnToDynamic; i++) {
-            if (predicate(this->_array[i]->getElement())) {
-                newArrayPhysicalSize++;
-            }
-        }
-
-        if (!newArrayPhysicalSize) { newArrayPhysicalSize = 1; }
-
-        Unique<E> **newArray = new Unique<E> *[newArrayPhysicalSize];
-        initUniqueArray(newArray, newArrayPhysicalSize);
-
-        copyArraysBasedOnPredicate(predicate, newArray);
-
-        this->deleteThis();
-        this->_array        = newArray;
-        this->_physicalSize = newArrayPhysicalSize;
+        setFilteredSize(filterRange(predicate, 0, sizeToIterateOnToDynamic));
         return *this;
     }
 
-  protected:
-    void copyArraysBasedOnPredicate(const std::function<bool(E *)> &predicate,
-                                    Unique<E> **                    newArray) {
-        copyArraysBasedOnPredicateStatic(_array, newArray, _physicalSize,
-                                         predicate);
-    }
-
-  protected:
-    void copyArraysStatic(Unique<E> **source, Unique<E> **destination,
-                          unsigned long size) {
-        copyArraysBasedOnPredicateStatic(source, destination, size,
-                                         [](auto *) { return true; });
-    }
-
-  protected:
-    static void copyArraysBasedOnPredicateStatic(
-            Unique<E> **source, Unique<E> **destination, unsigned long size,
-            const std::function<bool(E *)> &predicate) {
-        for (unsigned long i = 0; i < size; i++) {
-            E *element = source[i]->getElement();
-            if (predicate(element)) {
-
-                /*
-                 * - If element is originally a "lvalue", then shallow-copy the
-                 *   pointer.
-                 * - else if the element is originally a "rvalue", then
-                 *   deep-copy the pointer.
-                 */
-                if (!source[i]->isNeedToDeleteElement()) {
-
-                    // Shallow-Copy the pointer within unique.
-                    destination[i] = source[i];
-                } else if (source[i]->isNeedToDeleteElement()) {
-
-                    // Deep-Copy the pointer within unique.
-                    destination[i] = new Unique<E>(*source[i]);
-                }
-                continue;
-            }
-        }
-    }
-
   public:
     /**
      * @brief This method will *map* out another `Array` from `this` array.
@@ -418,9 +454,9 @@ template<typename E> class BaseArray : public Object {
      *         may also "chain" this method with another.
      */
     template<typename E2>
-    BaseArray<E2> map(const std::function<E2 *(E *)> &mapFunction,
-                      bool                            isAnonymous       = false,
-                      unsigned long                   sizeToIterateOnTo = 0) {
+    Rebind<E2> map(const std::function<E2 *(E *)> &mapFunction,
+                   bool                            isAnonymous       = false,
+                   unsigned long                   sizeToIterateOnTo = 0) {
         unsigned long sizeToIterateOnToDynamic =
                 getSizeToIterateOnToDynamic(sizeToIterateOnTo);
 
@@ -429,9 +465,10 @@ template<typename E> class BaseArray : public Object {
          * The `for-loop`'s content is:
          * - `insert` the new mapped-elements to `newArray`.
          */
-        BaseArray<E2> e2Array(sizeToIterateOnToDynamic);
+        Rebind<E2> e2Array(sizeToIterateOnToDynamic,
+                           BasicAllocations::Rebind<E2, Allocator>(_allocator));
         for (unsigned long i = 0; i < sizeToIterateOnToDynamic; i++) {
-            E *element = this->_array[i]->getElement();
+            E *element = &this->_array[i];
             e2Array.setElement(mapFunction(element), i, isAnonymous);
         }
 
@@ -460,8 +497,8 @@ template<typename E> class BaseArray : public Object {
      *         may also "chain" this method with another.
      */
     template<typename E2>
-    BaseArray<E2> map(const std::function<E2 && (E *)> &mapFunction,
-                      unsigned long                     sizeToIterateOnTo = 0) {
+    Rebind<E2> map(const std::function<E2 && (E *)> &mapFunction,
+                   unsigned long                     sizeToIterateOnTo = 0) {
         unsigned long sizeToIterateOnToDynamic =
                 getSizeToIterateOnToDynamic(sizeToIterateOnTo);
 
@@ -470,15 +507,337 @@ template<typename E> class BaseArray : public Object {
          * The `for-loop`'s content is:
          * - `insert` the new mapped-elements to `newArray`.
          */
-        BaseArray<E2> e2Array(sizeToIterateOnToDynamic);
+        Rebind<E2> e2Array(sizeToIterateOnToDynamic,
+                           BasicAllocations::Rebind<E2, Allocator>(_allocator));
         for (unsigned long i = 0; i < sizeToIterateOnToDynamic; i++) {
-            E *element = this->_array[i]->getElement();
+            E *element = &this->_array[i];
             e2Array.setElement(mapFunction(element), i);
         }
 
         return e2Array;
     }
 
+  public:
+    /**
+     * @brief The same as the @link forEach @endlink method above, for *any*
+     *        callable @p callBack - which is invoked *directly*, instead of
+     *        via a `std::function`. That way, the @p callBack may be inlined.
+     *
+     * @tparam Function the type of a `void` callable, that accepts an `E *`.
+     * @see forEach(const std::function<void(E *)> &, unsigned long)
+     */
+    template<typename Function>
+    BaseArray &forEach(Function &&    callBack,
+                       unsigned long sizeToIterateOnTo = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        for (unsigned long i = 0; i < sizeToIterateOnToDynamic; i++) {
+            callBack(&this->_array[i]);
+        }
+
+        return *this;
+    }
+
+  public:
+    /**
+     * @brief The same as the @link filter @endlink method above, for *any*
+     *        callable @p predicate - which is invoked *directly*, instead of
+     *        via a `std::function`.
+     *
+     * @tparam Function the type of a `bool` callable, that accepts an `E *`.
+     * @see filter(const std::function<bool(E *)> &, unsigned long)
+     */
+    template<typename Function>
+    BaseArray &filter(Function &&    predicate,
+                      unsigned long sizeToIterateOnTo = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        setFilteredSize(filterRange(predicate, 0, sizeToIterateOnToDynamic));
+        return *this;
+    }
+
+  public:
+    /**
+     * @brief The same as the @link map @endlink method above, for *any*
+     *        callable @p mapFunction that returns an `E2 *` - which is
+     *        invoked *directly*, instead of via a `std::function`.
+     *
+     * @tparam E2 the type of `element`s in the returned `Array`.
+     * @tparam Function the type of a callable, that accepts an `E *` and
+     *                  returns an `E2 *`.
+     * @see map(const std::function<E2 *(E *)> &, bool, unsigned long)
+     */
+    template<typename E2, typename Function,
+             typename std::enable_if<IsPointerMapFunction<Function, E2>::value,
+                                     int>::type = 0>
+    Rebind<E2> map(Function &&mapFunction, bool isAnonymous = false,
+                   unsigned long sizeToIterateOnTo = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        Rebind<E2> e2Array(sizeToIterateOnToDynamic,
+                           BasicAllocations::Rebind<E2, Allocator>(_allocator));
+        mapRange(e2Array, mapFunction, isAnonymous, 0,
+                 sizeToIterateOnToDynamic);
+        return e2Array;
+    }
+
+  public:
+    /**
+     * @brief The same as the @link map @endlink method above, for *any*
+     *        callable @p mapFunction that returns an `E2` *by value* - which
+     *        is invoked *directly*, instead of via a `std::function`.
+     *
+     * @note Unlike the `std::function<E2 && (E *)>` overload, the value
+     *       returned by the @p mapFunction may be a temporary. For example,
+     *       mapping a `std::string` array to an `int` array:
+     * @code
+     * auto intArray = stringArray.map<int>(
+     *         [](std::string *s) { return std::stoi(*s); });
+     * @endcode
+     *
+     * @tparam E2 the type of `element`s in the returned `Array`.
+     * @tparam Function the type of a callable, that accepts an `E *` and
+     *                  returns a value convertible to `E2`.
+     * @see map(const std::function<E2 && (E *)> &, unsigned long)
+     */
+    template<typename E2, typename Function,
+             typename std::enable_if<!IsPointerMapFunction<Function, E2>::value,
+                                     int>::type = 0>
+    Rebind<E2> map(Function &&    mapFunction,
+                   unsigned long sizeToIterateOnTo = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        Rebind<E2> e2Array(sizeToIterateOnToDynamic,
+                           BasicAllocations::Rebind<E2, Allocator>(_allocator));
+        mapRange(e2Array, mapFunction, false, 0, sizeToIterateOnToDynamic);
+        return e2Array;
+    }
+
+  public:
+    /**
+     * @brief The *parallel* version of the @link forEach @endlink method.
+     *
+     * The array is divided to contiguous *chunks*, and each chunk is
+     * iterated on by a thread of its own.
+     * @see BasicAlgorithms::parallelForEachChunk
+     *
+     * @attention the @p callBack is invoked *concurrently* - so it must be
+     *            safe to invoke it on *different* elements at the same time.
+     * @param threadCount the maximum amount of threads to use. `0` means the
+     *                    amount of hardware threads available.
+     * @return `this` object. So that you may "chain" this method with another.
+     */
+    template<typename Function>
+    BaseArray &parallelForEach(Function &&    callBack,
+                               unsigned long sizeToIterateOnTo = 0,
+                               unsigned long threadCount       = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        BasicAlgorithms::parallelForEachChunk(
+                sizeToIterateOnToDynamic,
+                [this, &callBack](unsigned long, unsigned long begin,
+                                  unsigned long end) {
+                    for (unsigned long i = begin; i < end; i++) {
+                        callBack(&this->_array[i]);
+                    }
+                },
+                threadCount);
+
+        return *this;
+    }
+
+  public:
+    /**
+     * @brief The *parallel* version of the @link filter @endlink method.
+     *
+     * Each chunk of the array is filtered by a thread of its own - to the
+     * front of the chunk. Then, the elements that remain in each chunk are
+     * *moved* to the front of the array, chunk after chunk.
+     * That way, the elements that remain keep their order, and the
+     * @p predicate is invoked *once* on each element.
+     *
+     * @attention the @p predicate is invoked *concurrently* - so it must be
+     *            safe to invoke it on *different* elements at the same time.
+     * @param threadCount the maximum amount of threads to use. `0` means the
+     *                    amount of hardware threads available.
+     * @return `this` object. So that you may "chain" this method with another.
+     */
+    template<typename Function>
+    BaseArray &parallelFilter(Function &&    predicate,
+                              unsigned long sizeToIterateOnTo = 0,
+                              unsigned long threadCount       = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        std::vector<unsigned long> chunkBegins(BasicAlgorithms::getChunkCount(
+                sizeToIterateOnToDynamic, threadCount));
+        std::vector<unsigned long> chunkEnds(chunkBegins.size());
+        BasicAlgorithms::parallelForEachChunk(
+                sizeToIterateOnToDynamic,
+                [&](unsigned long chunkIndex, unsigned long begin,
+                    unsigned long end) {
+                    chunkBegins[chunkIndex] = begin;
+                    chunkEnds[chunkIndex] = filterRange(predicate, begin, end);
+                },
+                threadCount);
+
+        // Move the remaining elements of each chunk to the front of the array.
+        unsigned long newArrayPhysicalSize = 0;
+        for (unsigned long chunk = 0; chunk < chunkBegins.size(); chunk++) {
+            for (unsigned long i = chunkBegins[chunk]; i < chunkEnds[chunk];
+                 i++) {
+                if (newArrayPhysicalSize != i) {
+                    _array[newArrayPhysicalSize] = (E &&) _array[i];
+                }
+                newArrayPhysicalSize++;
+            }
+        }
+
+        setFilteredSize(newArrayPhysicalSize);
+        return *this;
+    }
+
+  public:
+    /**
+     * @brief The *parallel* version of the @link map @endlink method, for a
+     *        @p mapFunction that returns an `E2 *`.
+     *
+     * @attention the @p mapFunction is invoked *concurrently* - so it must
+     *            be safe to invoke it on *different* elements at the same
+     *            time.
+     * @param threadCount the maximum amount of threads to use. `0` means the
+     *                    amount of hardware threads available.
+     * @return the array of type `E2` mapped by `this` array.
+     */
+    template<typename E2, typename Function,
+             typename std::enable_if<IsPointerMapFunction<Function, E2>::value,
+                                     int>::type = 0>
+    Rebind<E2> parallelMap(Function &&mapFunction, bool isAnonymous = false,
+                           unsigned long sizeToIterateOnTo = 0,
+                           unsigned long threadCount       = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        Rebind<E2> e2Array(sizeToIterateOnToDynamic,
+                           BasicAllocations::Rebind<E2, Allocator>(_allocator));
+        BasicAlgorithms::parallelForEachChunk(
+                sizeToIterateOnToDynamic,
+                [&](unsigned long, unsigned long begin, unsigned long end) {
+                    mapRange(e2Array, mapFunction, isAnonymous, begin, end);
+                },
+                threadCount);
+        return e2Array;
+    }
+
+  public:
+    /**
+     * @brief The *parallel* version of the @link map @endlink method, for a
+     *        @p mapFunction that returns an `E2` *by value*.
+     *
+     * @attention the @p mapFunction is invoked *concurrently* - so it must
+     *            be safe to invoke it on *different* elements at the same
+     *            time.
+     * @param threadCount the maximum amount of threads to use. `0` means the
+     *                    amount of hardware threads available.
+     * @return the array of type `E2` mapped by `this` array.
+     */
+    template<typename E2, typename Function,
+             typename std::enable_if<!IsPointerMapFunction<Function, E2>::value,
+                                     int>::type = 0>
+    Rebind<E2> parallelMap(Function &&    mapFunction,
+                           unsigned long sizeToIterateOnTo = 0,
+                           unsigned long threadCount       = 0) {
+        unsigned long sizeToIterateOnToDynamic =
+                getSizeToIterateOnToDynamic(sizeToIterateOnTo);
+
+        Rebind<E2> e2Array(sizeToIterateOnToDynamic,
+                           BasicAllocations::Rebind<E2, Allocator>(_allocator));
+        BasicAlgorithms::parallelForEachChunk(
+                sizeToIterateOnToDynamic,
+                [&](unsigned long, unsigned long begin, unsigned long end) {
+                    mapRange(e2Array, mapFunction, false, begin, end);
+                },
+                threadCount);
+        return e2Array;
+    }
+
+  protected:
+    /**
+     * @brief *Moves* the elements in the range `[begin, end)` that return
+     *        `true` to the given @p predicate, to the front of that range.
+     *
+     * @return the end of the elements that remain in the range.
+     */
+    template<typename Function>
+    unsigned long filterRange(Function &predicate, unsigned long begin,
+                              unsigned long end) {
+        unsigned long newEnd = begin;
+        for (unsigned long i = begin; i < end; i++) {
+            if (predicate(&this->_array[i])) {
+                if (newEnd != i) { _array[newEnd] = (E &&) _array[i]; }
+                newEnd++;
+            }
+        }
+        return newEnd;
+    }
+
+  protected:
+    /**
+     * @brief Sets the size of the array to @p newArrayPhysicalSize, after the
+     *        remaining elements were moved to its front.
+     *
+     * @note in case all of the array got filtered out, then the array
+     *       remains with a physicalSize of `1` with a default `E` as its
+     *       first element.
+     */
+    void setFilteredSize(unsigned long newArrayPhysicalSize) {
+        if (!newArrayPhysicalSize) {
+            _array[0]            = E();
+            newArrayPhysicalSize = 1;
+        }
+
+        destroyElements(_array + newArrayPhysicalSize,
+                        _physicalSize - newArrayPhysicalSize);
+        this->_physicalSize = newArrayPhysicalSize;
+    }
+
+  protected:
+    /**
+     * @brief Sets each element in the range `[begin, end)` of the
+     *        @p e2Array, to the element mapped from the element in the same
+     *        index in `this` array.
+     */
+    template<typename E2, typename Function>
+    void mapRange(Rebind<E2> &e2Array, Function &mapFunction, bool isAnonymous,
+                  unsigned long begin, unsigned long end) {
+        for (unsigned long i = begin; i < end; i++) {
+            setMappedElement<E2>(
+                    e2Array, mapFunction(&this->_array[i]), i, isAnonymous,
+                    std::integral_constant<
+                            bool, IsPointerMapFunction<Function, E2>::value>());
+        }
+    }
+
+  protected:
+    template<typename E2>
+    static void setMappedElement(Rebind<E2> &e2Array, E2 *mappedElement,
+                                 unsigned long index, bool isAnonymous,
+                                 std::true_type) {
+        e2Array.setElement(mappedElement, index, isAnonymous);
+    }
+
+  protected:
+    template<typename E2, typename Result>
+    static void setMappedElement(Rebind<E2> &e2Array, Result &&mappedElement,
+                                 unsigned long index, bool, std::false_type) {
+        e2Array.setElement(E2(std::forward<Result>(mappedElement)), index);
+    }
+
   private:
     unsigned long getSizeToIterateOnToDynamic(unsigned long sizeToIterateOnTo) {
         return getSizeToIterateOnToDynamicStatic(sizeToIterateOnTo,
@@ -496,7 +855,7 @@ template<typename E> class BaseArray : public Object {
                 std::string msg2 =
                         (char *) "You picked a size that is larger than the "
                                  "current `physicalSize` of :" +
-                        physicalSize;
+                        std::to_string(physicalSize);
                 throw std::out_of_range(msg + " " + msg2);
             }
             sizeToIterateOnToDynamic = sizeToIterateOnTo;
@@ -506,13 +865,13 @@ template<typename E> class BaseArray : public Object {
 
   public:
     /**
-     * @brief Shallow-Copying `this` object.
-     * @return a shallow-copy of `this` object.
+     * @brief Deep-Copying `this` object.
+     * @return a deep-copy of `this` object.
      */
-    BaseArray<E> &copy() {
-        BaseArray<E> copyArray(_physicalSize);
+    BaseArray copy() {
+        BaseArray copyArray(_physicalSize, _allocator);
         for (unsigned long i = 0; i < _physicalSize; i++) {
-            copyArray._array[i] = _array[i]; // Shallow-Copy the reference.
+            copyArray._array[i] = _array[i]; // Deep-Copy the element.
         }
 
         return copyArray;
@@ -551,9 +910,8 @@ template<typename E> class BaseArray : public Object {
             const std::function<E(E &, E &)> &callBack) {
         for (unsigned long i = indexOfFirstElementToManipulateWith;
              i < indexOfLastElementToManipulateWith + 1; i++) {
-            setElement((E) callBack(getElement(indexOfElementToManipulate),
-                                    getElement(i)),
-                       indexOfElementToManipulate);
+            E &destination = getElement(indexOfElementToManipulate);
+            destination    = callBack(destination, getElement(i));
         }
     }
 
@@ -572,32 +930,26 @@ template<typename E> class BaseArray : public Object {
     }
 
   public:
+    /**
+     * @brief Removes the elements in the range
+     *        `[startIndexToDeleteFrom, endIndexToDeleteTo]` from the array.
+     *
+     * The elements after the range are *moved* backwards, *in-place* - so
+     * the array is never reallocated. Its buffer keeps its capacity.
+     */
     void shortenArray(unsigned long startIndexToDeleteFrom,
                       unsigned long endIndexToDeleteTo) {
         auto sizeOfAllTheElementsMerged =
                 endIndexToDeleteTo + 1 - startIndexToDeleteFrom;
-        auto        newArraySize = _physicalSize - sizeOfAllTheElementsMerged;
-        Unique<E> **newArray     = new Unique<E> *[newArraySize];
-        for (unsigned long i = 0; i < _physicalSize; i++) {
+        auto newArraySize = _physicalSize - sizeOfAllTheElementsMerged;
 
-            /*
-             * Shallow-Copy pointers.
-             * If the element is marked for `delete`, then don't copy it.
-             * Instead, `delete` it.
-             */
-            if ((startIndexToDeleteFrom <= i) && (i <= endIndexToDeleteTo)) {
-                delete _array[i];
-                continue;
-            }
-
-            newArray[i] = _array[i];
+        // Move the elements after the range, to the start of the range.
+        for (unsigned long i = endIndexToDeleteTo + 1; i < _physicalSize; i++) {
+            _array[i - sizeOfAllTheElementsMerged] = (E &&) _array[i];
         }
 
-        // Delete the old array pointer.
-        delete[] _array;
-
-        // Set the new array pointer to `newArray` pointer.
-        _array = newArray;
+        // Delete the moved-from elements at the end of the array.
+        destroyElements(_array + newArraySize, sizeOfAllTheElementsMerged);
 
         // Set the new _physicalSize to `newArraySize`.
         _physicalSize = newArraySize;
@@ -607,7 +959,18 @@ template<typename E> class BaseArray : public Object {
     BaseArray &operator=(const BaseArray &other) = delete;
 
   public:
-    BaseArray &operator=(BaseArray &&other) noexcept {
+    /**
+     * @brief Takes the buffer of the @p other array - unless it is inline,
+     *        or the `Allocator` does not propagate on move-assignment and
+     *        the two allocators are not equal (for example, two
+     *        `std::pmr::polymorphic_allocator`s over different resources).
+     *        Then, each element is moved to a buffer of `this` array's
+     *        allocator instead.
+     */
+    BaseArray &operator=(BaseArray &&other) noexcept(
+            std::allocator_traits<
+                    Allocator>::propagate_on_container_move_assignment::value ||
+            std::allocator_traits<Allocator>::is_always_equal::value) {
 
         // Guard self assignment
         if (this != &other) {
@@ -615,19 +978,36 @@ template<typename E> class BaseArray : public Object {
             // Free the existing resource.
             deleteThis();
 
-            // Copy the all pointers and primitives  from the source object.
-            this->_physicalSize = other._physicalSize;
-            _array              = other._array;
-            for (unsigned long i = 0; i < _physicalSize; i++) {
-                _array[i] = other._array[i];
+            BasicAllocations::propagateOnMoveAssignment(this->_allocator,
+                                                        other._allocator);
+            if (other.isInlineBuffer(other._array) ||
+                !(_allocator == other._allocator)) {
+
+                // Move each element, as the buffer can not be taken.
+                _array = allocateBuffer(other._physicalSize);
+                for (unsigned long i = 0; i < other._physicalSize; i++) {
+                    std::allocator_traits<Allocator>::construct(
+                            _allocator, &_array[i], (E &&) other._array[i]);
+                }
+                this->_physicalSize = other._physicalSize;
+                this->_capacity     = other._physicalSize;
+
+                // Freed by its own allocator.
+                other.deleteThis();
+                return *this;
             }
 
+            // Take the buffer pointer from the source object.
+            _array              = other._array;
+            this->_physicalSize = other._physicalSize;
+            this->_capacity     = other._capacity;
+
             /*
              * Release the data pointer from the source object so that
              * the destructor does not free the memory multiple times.
              */
-            other.forEach([&other](auto *e) { e = nullptr; });
             other._physicalSize = 0;
+            other._capacity     = 0;
             other._array        = nullptr;
         }
         return *this;
@@ -650,12 +1030,10 @@ template<typename E> class BaseArray : public Object {
                                                   array._physicalSize);
 
         os << '[';
-        if (sizeToIterateOnToDynamic) {
-            printElement(os, (array._array[0])->getElement());
-        }
+        if (sizeToIterateOnToDynamic) { printElement(os, &array._array[0]); }
         for (unsigned long i = 1; i < sizeToIterateOnToDynamic; i++) {
             os << " ,";
-            printElement(os, (array._array[i])->getElement());
+            printElement(os, &array._array[i]);
         }
         os << ']';
         return os;
@@ -5,6 +5,13 @@
 #include "Constants.h"
 #include <exception>
 #include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 /**
  * @brief this class bundles together all the generic algorithms
@@ -179,6 +186,118 @@ class BasicAlgorithms {
         element1 = element2;
         element2 = tmp;
     }
+
+  public:
+    /// The least amount of elements worth handing to a thread of its own.
+    static constexpr unsigned long PARALLEL_MINIMUM_CHUNK_SIZE = 1UL << 14;
+
+  public:
+    /**
+     * @brief Divides the range `[0, size)` into contiguous *chunks*, and
+     *        invokes the given @p chunkFunction on each chunk - each chunk
+     *        on a thread of its own.
+     *
+     * The calling thread works on the last chunk by itself, and then waits
+     * for the other threads to finish.
+     *
+     * For example:
+     * @code
+     * BasicAlgorithms::parallelForEachChunk(
+     *         size, [&](unsigned long chunkIndex, unsigned long begin,
+     *                   unsigned long end) {
+     *             for (unsigned long i = begin; i < end; i++) { array[i]++; }
+     *         });
+     * @endcode
+     *
+     * @param size the size of the range to divide.
+     * @param chunkFunction a `void` function that is invoked with the index
+     *                      of the chunk, and the `begin` (inclusive) and `end`
+     *                      (exclusive) indexes of the chunk.
+     * @param threadCount the maximum amount of threads to use. `0` means the
+     *                    amount of hardware threads available.
+     * @return the amount of chunks the range was divided to. The chunks are
+     *         ordered by their index - chunk `i` is before chunk `i + 1`.
+     * @throws the first exception thrown by the @p chunkFunction, after
+     *         all the threads have finished - or `std::system_error` in case
+     *         a thread could not be started, after the threads that were
+     *         started have finished.
+     */
+    template<typename ChunkFunction>
+    static unsigned long parallelForEachChunk(unsigned long  size,
+                                              ChunkFunction &&chunkFunction,
+                                              unsigned long  threadCount = 0) {
+        unsigned long chunkCount = getChunkCount(size, threadCount);
+        if (chunkCount <= 1) {
+            chunkFunction(0UL, 0UL, size);
+            return 1;
+        }
+
+        std::vector<std::exception_ptr> exceptions(chunkCount);
+        auto runChunk = [&](unsigned long chunkIndex) {
+            try {
+                chunkFunction(chunkIndex, size * chunkIndex / chunkCount,
+                              size * (chunkIndex + 1) / chunkCount);
+            } catch (...) { exceptions[chunkIndex] = std::current_exception(); }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        try {
+            for (unsigned long i = 0; i < chunkCount - 1; i++) {
+                threads.emplace_back(runChunk, i);
+            }
+        } catch (...) {
+
+            // A thread could not be started - the threads that were started
+            // must be joined before they are destroyed.
+            for (auto &thread : threads) { thread.join(); }
+            throw;
+        }
+        runChunk(chunkCount - 1);
+        for (auto &thread : threads) { thread.join(); }
+
+        for (auto &exception : exceptions) {
+            if (exception) { std::rethrow_exception(exception); }
+        }
+        return chunkCount;
+    }
+
+  public:
+    /**
+     * @brief Pins the given @p thread to run only on the given @p cpu.
+     *
+     * @param thread the native handle of the thread to pin - for example,
+     *               `std::thread::native_handle()`.
+     * @param cpu the index of the CPU - modulo the amount of hardware
+     *            threads available.
+     * @return `true` if the @p thread was pinned. Else, `false` - for example,
+     *         on a platform that does not support it.
+     */
+    static bool pinThreadToCpu(std::thread::native_handle_type thread,
+                               unsigned long                   cpu) {
+#ifdef __linux__
+        unsigned long cpuCount = std::thread::hardware_concurrency();
+        cpu_set_t     cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuCount ? cpu % cpuCount : 0, &cpuSet);
+        return pthread_setaffinity_np(thread, sizeof(cpuSet), &cpuSet) == 0;
+#else
+        return false;
+#endif
+    }
+
+  public:
+    /**
+     * @return the amount of chunks that @link parallelForEachChunk @endlink
+     *         divides a range of the given @p size to.
+     */
+    static unsigned long getChunkCount(unsigned long size,
+                                       unsigned long threadCount = 0) {
+        if (!threadCount) { threadCount = std::thread::hardware_concurrency(); }
+        unsigned long chunkCount = size / PARALLEL_MINIMUM_CHUNK_SIZE;
+        if (chunkCount > threadCount) { chunkCount = threadCount; }
+        return chunkCount ? chunkCount : 1;
+    }
 };
 
 #endif // BASIC_ALGORITHMS_H
@@ -0,0 +1,158 @@
+
+#ifndef BASIC_ALLOCATIONS_H
+#define BASIC_ALLOCATIONS_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief this class bundles together all the generic allocation methods in
+ *        the program, so that every container may route its arrays and
+ *        nodes through a *std-allocator compatible* `Allocator` instead of
+ *        the raw `new` and `delete` operators.
+ *
+ * The given `Allocator` may be of *any* `value_type`. Each method
+ * *rebinds* it to the type actually being allocated, the same way the
+ * standard containers do.
+ *
+ * For example:
+ * @code
+ * std::allocator<int> allocator;
+ * auto *array = BasicAllocations::allocateArray<std::string *>(allocator, 8);
+ * BasicAllocations::deallocateArray(allocator, array, 8);
+ *
+ * auto *str = BasicAllocations::create<std::string>(allocator, "hello");
+ * BasicAllocations::destroy(allocator, str);
+ * @endcode
+ */
+class BasicAllocations {
+
+  public:
+    /**
+     * @brief The `Allocator` given, *rebound* to allocate objects of type `T`.
+     * @tparam T the type of objects to allocate.
+     * @tparam Allocator a std-allocator compatible allocator of any type.
+     */
+    template<typename T, typename Allocator>
+    using Rebind =
+            typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  public:
+    /**
+     * @brief Allocates an *uninitialized* array of @p size elements of type
+     *        `T` via the given @p allocator.
+     *
+     * @note The elements are *not* constructed. This method is meant for
+     *       arrays of pointers and other *trivial* types.
+     * @param allocator the allocator to allocate the array with.
+     * @param size the amount of elements in the array.
+     * @return the array allocated.
+     */
+    template<typename T, typename Allocator>
+    static T *allocateArray(const Allocator &allocator, unsigned long size) {
+        Rebind<T, Allocator> rebound(allocator);
+        return std::allocator_traits<Rebind<T, Allocator>>::allocate(rebound,
+                                                                     size);
+    }
+
+  public:
+    /**
+     * @brief Deallocates an array that was allocated with the
+     *        @link allocateArray @endlink method.
+     *
+     * @note `nullptr` resistant - does nothing for a `nullptr` @p array.
+     * @param allocator the allocator the array was allocated with.
+     * @param array the array to deallocate.
+     * @param size the amount of elements the array was allocated with.
+     */
+    template<typename T, typename Allocator>
+    static void deallocateArray(const Allocator &allocator, T *array,
+                                unsigned long size) {
+        if (array == nullptr) { return; }
+        Rebind<T, Allocator> rebound(allocator);
+        std::allocator_traits<Rebind<T, Allocator>>::deallocate(rebound, array,
+                                                                size);
+    }
+
+  public:
+    /**
+     * @brief Allocates a single `T` via the given @p allocator and
+     *        constructs it with the given @p args.
+     *
+     * This is the allocator-aware version of `new T(args...)`.
+     * @param allocator the allocator to allocate the object with.
+     * @param args the arguments to construct the object with.
+     * @return the object created.
+     */
+    template<typename T, typename Allocator, typename... Args>
+    static T *create(const Allocator &allocator, Args &&...args) {
+        Rebind<T, Allocator> rebound(allocator);
+        T *object = std::allocator_traits<Rebind<T, Allocator>>::allocate(
+                rebound, 1);
+        try {
+            std::allocator_traits<Rebind<T, Allocator>>::construct(
+                    rebound, object, std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator_traits<Rebind<T, Allocator>>::deallocate(rebound,
+                                                                    object, 1);
+            throw;
+        }
+        return object;
+    }
+
+  public:
+    /**
+     * @brief Destructs and deallocates an object that was created with the
+     *        @link create @endlink method.
+     *
+     * This is the allocator-aware version of `delete object`.
+     * @note `nullptr` resistant - does nothing for a `nullptr` @p object.
+     * @param allocator the allocator the object was created with.
+     * @param object the object to destroy.
+     */
+    template<typename T, typename Allocator>
+    static void destroy(const Allocator &allocator, T *object) {
+        if (object == nullptr) { return; }
+        Rebind<T, Allocator> rebound(allocator);
+        std::allocator_traits<Rebind<T, Allocator>>::destroy(rebound, object);
+        std::allocator_traits<Rebind<T, Allocator>>::deallocate(rebound, object,
+                                                                1);
+    }
+
+  public:
+    /**
+     * @brief Move-assigns the @p source allocator to the @p destination
+     *        allocator, *only* if the `Allocator` wishes to propagate on
+     *        a container's move-assignment.
+     *
+     * @note Allocators that do *not* propagate (for example,
+     *       `std::pmr::polymorphic_allocator`) are *not* assignable - a
+     *       container whose allocator is not equal to the @p source
+     *       allocator must then move its elements one by one.
+     * @param destination the allocator of the container assigned to.
+     * @param source the allocator of the container moved from.
+     */
+    template<typename Allocator>
+    static void propagateOnMoveAssignment(Allocator &destination,
+                                          Allocator &source) {
+        propagateOnMoveAssignment(
+                destination, source,
+                typename std::allocator_traits<
+                        Allocator>::propagate_on_container_move_assignment());
+    }
+
+  private:
+    template<typename Allocator>
+    static void propagateOnMoveAssignment(Allocator &destination,
+                                          Allocator &source, std::true_type) {
+        destination = std::move(source);
+    }
+
+  private:
+    template<typename Allocator>
+    static void propagateOnMoveAssignment(Allocator &, Allocator &,
+                                          std::false_type) {}
+};
+
+#endif // BASIC_ALLOCATIONS_H
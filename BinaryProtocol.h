@@ -0,0 +1,341 @@
+
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#include "CommandDecoder.h"
+#include "Constants.h"
+#include "Entry.h"
+#include "OutputWriter.h"
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief This class encodes and decodes the *binary* format of the
+ *        commands, and of their results - an alternative to the text format,
+ *        that needs neither formatting nor parsing of numbers as text.
+ *
+ * The binary *commands* stream is:
+ * @li A header - the `COMMANDS_MAGIC` bytes, followed by the `VERSION` byte.
+ * @li The number of commands, as a *varint*.
+ * @li Each command - its letter as a single byte. An `f` command is
+ *     followed by its key as a *zig-zag varint*, and its value as a
+ *     *varint* length followed by the bytes of the value.
+ * @li A text line that is not a valid command is encoded as a single
+ *     `INVALID_COMMAND_TAG` byte - and a number of commands that is not
+ *     valid, as `0` - so that they are rejected at the same point as the
+ *     text.
+ *
+ * The binary *results* stream is:
+ * @li A header - the `RESULTS_MAGIC` bytes, followed by the `VERSION` byte.
+ * @li Each result - a `RESULT_TAG` byte, followed by the key and the value
+ *     of the result, encoded as in an `f` command.
+ * @li In case of a wrong input - a single `ERROR_TAG` byte, after the
+ *     results before it.
+ *
+ * A *varint* holds 7 bits in each byte - from the least significant - with
+ * the highest bit set on all of its bytes but the last. A *zig-zag* varint
+ * maps the signed key to an unsigned one first, so that keys of a small
+ * magnitude take a single byte, whether negative or not.
+ *
+ * The commands are accepted by the same rules as their text lines (see
+ * `CommandDecoder`), and the number of commands must be the same as the
+ * number declared - there must be no bytes after the last command.
+ *
+ * For example:
+ * @code
+ * std::string commands;
+ * BinaryProtocol::appendHeader(commands, BinaryProtocol::COMMANDS_MAGIC);
+ * BinaryProtocol::appendVarint(commands, 2);
+ * BinaryProtocol::appendCommand(commands, {'e'});
+ * BinaryProtocol::appendCommand(commands, {'f', -3, "hi"});
+ * // commands == "\x89PQC\x01\x02" "e" "f\x05\x02hi"
+ * @endcode
+ *
+ * @see TestRunner
+ * @version 1.0
+ */
+class BinaryProtocol {
+
+  public:
+    /// The first bytes of a binary commands stream.
+    static constexpr std::string_view COMMANDS_MAGIC = "\x89PQC";
+
+  public:
+    /// The first bytes of a binary results stream.
+    static constexpr std::string_view RESULTS_MAGIC = "\x89PQR";
+
+  public:
+    /// The version of the format, after the magic bytes.
+    static constexpr unsigned char VERSION = 1;
+
+  public:
+    /**
+     * The byte of a command that is not valid - never a valid letter, so it
+     * is rejected by @link readCommand @endlink.
+     */
+    static constexpr unsigned char INVALID_COMMAND_TAG = '?';
+
+  public:
+    /// The byte before each result in the results stream.
+    static constexpr unsigned char RESULT_TAG = 'r';
+
+  public:
+    /// The byte that ends the results stream, in case of a wrong input.
+    static constexpr unsigned char ERROR_TAG = 'x';
+
+  protected:
+    /// The maximum amount of bytes of a *varint* of 64 bits.
+    static constexpr unsigned long MAXIMUM_VARINT_LENGTH = 10;
+
+  public:
+    /**
+     * @brief Thrown *after* the `ERROR_TAG` was written to the results
+     *        stream - so the wrong input should not be reported again.
+     */
+    class ErrorWritten : public std::runtime_error {
+
+      public:
+        ErrorWritten() : std::runtime_error(Constants::WRONG_INPUT) {}
+    };
+
+  public:
+    /**
+     * @return `true` if a stream that starts with the given @p firstByte is
+     *         a binary commands stream. Else, `false` - and it may be a text
+     *         commands stream.
+     * @note the first byte of the `COMMANDS_MAGIC` is not a digit, so a
+     *       valid text stream never starts with it.
+     */
+    static bool isBinaryCommands(char firstByte) {
+        return firstByte == COMMANDS_MAGIC[0];
+    }
+
+  public:
+    /// @return the *zig-zag* mapping of the given signed @p key.
+    static std::uint32_t toZigZag(int key) {
+        return ((std::uint32_t) key << 1) ^ (std::uint32_t) (key >> 31);
+    }
+
+  public:
+    /// @return the signed key of the given *zig-zag* mapping.
+    static int fromZigZag(std::uint32_t zigZag) {
+        return (int) ((zigZag >> 1) ^ (~(zigZag & 1) + 1));
+    }
+
+  public:
+    /// @brief Appends the given @p magic, followed by the `VERSION` byte.
+    static void appendHeader(std::string &output, std::string_view magic) {
+        output.append(magic);
+        output.push_back((char) VERSION);
+    }
+
+  public:
+    /// @brief Appends the given @p number as a *varint*.
+    static void appendVarint(std::string &output, std::uint64_t number) {
+        char          bytes[MAXIMUM_VARINT_LENGTH];
+        unsigned long length = encodeVarint(number, bytes);
+        output.append(bytes, length);
+    }
+
+  public:
+    /**
+     * @brief Appends the given @p command.
+     *
+     * @note the @p command is appended as it is, even if it is not valid.
+     */
+    static void appendCommand(std::string &                  output,
+                              const CommandDecoder::Command &command) {
+        output.push_back(command.opcode);
+        if (command.opcode == CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) {
+            appendVarint(output, toZigZag(command.key));
+            appendVarint(output, command.value.length());
+            output.append(command.value);
+        }
+    }
+
+  public:
+    /// @brief Writes the given @p magic, followed by the `VERSION` byte.
+    static void writeHeader(OutputWriter &writer, std::string_view magic) {
+        writer.write(magic);
+        writer.write((char) VERSION);
+    }
+
+  public:
+    /// @brief Writes the given @p entry as a result.
+    template<typename V>
+    static void writeResult(OutputWriter &writer, const Entry<int, V> &entry) {
+        std::string_view value = entry.getValueReference();
+
+        writer.write((char) RESULT_TAG);
+        writeVarint(writer, toZigZag(entry.getKeyReference()));
+        writeVarint(writer, value.length());
+        writer.write(value);
+    }
+
+  public:
+    /// @brief Writes the `ERROR_TAG`, that ends the results stream.
+    static void writeError(OutputWriter &writer) {
+        writer.write((char) ERROR_TAG);
+    }
+
+  public:
+    /**
+     * @brief Reads the header of a binary stream - the given @p magic bytes,
+     *        followed by the `VERSION` byte.
+     *
+     * @tparam ByteReader a reader of bytes - such as a `BufferedReader` or a
+     *                    `MappedFile` - which has `bool readByte(char &)`
+     *                    and `bool readView(unsigned long,
+     *                    std::string_view &)`.
+     * @throws std::runtime_error in case the header is not valid.
+     */
+    template<typename ByteReader>
+    static void readHeader(ByteReader &reader, std::string_view magic) {
+        std::string_view magicRead;
+        char             version = 0;
+        if (!reader.readView(magic.length(), magicRead) ||
+            (magicRead != magic) || !reader.readByte(version) ||
+            ((unsigned char) version != VERSION)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+    }
+
+  public:
+    /**
+     * @brief Reads the number of commands declared, after the header of a
+     *        binary commands stream.
+     *
+     * @return the number of commands declared - a positive `long`.
+     * @throws std::runtime_error in case the number is not valid.
+     * @see readHeader
+     */
+    template<typename ByteReader>
+    static unsigned long readNumberOfCommands(ByteReader &reader) {
+        std::uint64_t numberOfCommands = 0;
+        if (!tryReadVarint(reader, numberOfCommands) ||
+            (numberOfCommands < 1) ||
+            (numberOfCommands > (std::uint64_t) LONG_MAX)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+        return (unsigned long) numberOfCommands;
+    }
+
+  public:
+    /**
+     * @brief Reads the next command, by the same rules as the text line
+     *        of the given @p index.
+     *
+     * @param index the index of the command, among the commands after the
+     *              number of commands declared.
+     * @param command the command read. Its `value` views the @p reader -
+     *                so it is valid as long as the line of the @p reader is.
+     * @throws std::runtime_error in case the command is not valid, or in
+     *         case the input ends in the middle of it.
+     * @see readNumberOfCommands
+     */
+    template<typename ByteReader>
+    static void readCommand(ByteReader &reader, unsigned long index,
+                            CommandDecoder::Command &command) {
+        char letter = 0;
+        if (!reader.readByte(letter)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+
+        command.opcode = letter;
+        command.key    = 0;
+        command.value  = std::string_view();
+        if (!isValidLetter(command.opcode, index)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+        if (command.opcode != CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) {
+            return;
+        }
+
+        if (!tryReadKeyAndValue(reader, command.key, command.value)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+    }
+
+  public:
+    /**
+     * @brief Reads a *zig-zag varint* key, followed by a length-prefixed
+     *        value - as in an `f` command, or in a result.
+     * @return `true` if both were read. `false` in case the input ended in
+     *         the middle of them, or in case the key overflows an `int`.
+     */
+    template<typename ByteReader>
+    static bool tryReadKeyAndValue(ByteReader &reader, int &key,
+                                   std::string_view &value) {
+        std::uint64_t zigZag = 0;
+        std::uint64_t length = 0;
+        if (!tryReadVarint(reader, zigZag) || (zigZag > UINT32_MAX) ||
+            !tryReadVarint(reader, length) ||
+            !reader.readView((unsigned long) length, value)) {
+            return false;
+        }
+        key = fromZigZag((std::uint32_t) zigZag);
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Encodes the given @p number as a *varint*, into the given
+     *        @p output.
+     *
+     * @param output **must** be able to hold at least
+     *               `MAXIMUM_VARINT_LENGTH` bytes.
+     * @return the amount of bytes encoded.
+     */
+    static unsigned long encodeVarint(std::uint64_t number, char *output) {
+        unsigned long length = 0;
+        while (number >= 0x80) {
+            output[length++] = (char) ((number & 0x7F) | 0x80);
+            number >>= 7;
+        }
+        output[length++] = (char) number;
+        return length;
+    }
+
+  public:
+    /**
+     * @brief Reads a *varint*.
+     * @return `true` if a valid *varint* was read. `false` in case the input
+     *         ended in the middle of it, or in case it overflows 64 bits.
+     */
+    template<typename ByteReader>
+    static bool tryReadVarint(ByteReader &reader, std::uint64_t &number) {
+        number = 0;
+        for (unsigned long shift = 0; shift < 64; shift += 7) {
+            char byte = 0;
+            if (!reader.readByte(byte)) { return false; }
+
+            std::uint64_t bits = (unsigned char) byte & 0x7F;
+            if ((shift == 63) && (bits > 1)) { return false; }
+            number |= bits << shift;
+            if (!(byte & 0x80)) { return true; }
+        }
+        return false;
+    }
+
+  protected:
+    /// @brief Writes the given @p number as a *varint*.
+    static void writeVarint(OutputWriter &writer, std::uint64_t number) {
+        char          bytes[MAXIMUM_VARINT_LENGTH];
+        unsigned long length = encodeVarint(number, bytes);
+        writer.write(std::string_view(bytes, length));
+    }
+
+  protected:
+    /// @see CommandDecoder::tryDecode
+    static bool isValidLetter(char letter, unsigned long index) {
+        if (index == 0) { return letter == CommandDecoder::FIRST_LETTER; }
+        return (CommandDecoder::MINIMUM_LETTER <= letter) &&
+               (letter <= CommandDecoder::MAXIMUM_LETTER) &&
+               (letter != CommandDecoder::FIRST_LETTER);
+    }
+};
+
+#endif // BINARY_PROTOCOL_H
@@ -0,0 +1,302 @@
+
+#ifndef BUFFERED_READER_H
+#define BUFFERED_READER_H
+
+#include "Constants.h"
+#include "LineReaderAdt.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+/**
+ * @brief This class reads *lines* from an input, in large *blocks*.
+ *
+ * Instead of getting the input char by char, the input is read in blocks of
+ * `bufferSize` bytes at once - either with the `read()` system-call on a
+ * *file-descriptor*, or with `sgetn` on a `std::streambuf`. Each line is then
+ * found with a single `memchr` over the block.
+ *
+ * The lines are returned as `std::string_view`s:
+ * @li A line that is *within* a single block is viewed directly in the
+ *     block - without copying it.
+ * @li A line that spans over multiple blocks is gathered in a *reusable*
+ *     line-buffer - which is only reallocated for a line longer than any line
+ *     before it.
+ *
+ * For example:
+ * @code
+ * BufferedReader reader(STDIN_FILENO);
+ * std::string_view line;
+ * while (reader.getLine(line)) { std::cout << line << std::endl; }
+ * @endcode
+ *
+ * @attention a line returned is valid *only* until the next call to
+ *            @link getLine @endlink.
+ * @version 1.4
+ */
+class BufferedReader : public LineReaderAdt {
+
+  public:
+    /// The default size of a block read, in bytes.
+    static constexpr unsigned long DEFAULT_BUFFER_SIZE = 1UL << 16;
+
+  protected:
+    static constexpr char *READ_ERROR_MESSAGE =
+            (char *) "BufferedReader: failed to read from the input.";
+
+  protected:
+    static constexpr char *BUFFER_SIZE_MESSAGE =
+            (char *) "BufferedReader: `bufferSize` must be at least `1`.";
+
+  protected:
+    /// The file-descriptor to read from. `-1` when reading a `_streambuf`.
+    int _fd = -1;
+
+  protected:
+    /// The stream-buffer to read from. `nullptr` when reading an `_fd`.
+    std::streambuf *_streambuf = nullptr;
+
+  protected:
+    /// The block that the input is read into.
+    std::unique_ptr<char[]> _buffer;
+
+  protected:
+    unsigned long _bufferSize = 0;
+
+  protected:
+    /// The next char in the `_buffer`, that was not returned yet.
+    char *_position = nullptr;
+
+  protected:
+    /// The end of the chars that were read into the `_buffer`.
+    char *_end = nullptr;
+
+  protected:
+    /// Gathers a line that spans over multiple blocks.
+    std::string _lineBuffer;
+
+  protected:
+    /// Whether the end of the input was reached.
+    bool _isEndOfInput = false;
+
+  protected:
+    /// The amount of bytes read from the input so far.
+    unsigned long _bytesRead = 0;
+
+  public:
+    /**
+     * @param fd the file-descriptor to read from. It is *not* closed by
+     *           `this` reader.
+     * @param bufferSize the size of each block read, in bytes.
+     */
+    explicit BufferedReader(int           fd,
+                            unsigned long bufferSize = DEFAULT_BUFFER_SIZE)
+        : _fd(fd) {
+        initBuffer(bufferSize);
+    }
+
+  public:
+    /**
+     * @param istream the input-stream to read from - via its `rdbuf()`.
+     * @param bufferSize the size of each block read, in bytes.
+     */
+    explicit BufferedReader(std::istream &istream,
+                            unsigned long bufferSize = DEFAULT_BUFFER_SIZE)
+        : _streambuf(istream.rdbuf()) {
+        initBuffer(bufferSize);
+    }
+
+  protected:
+    /// For a subclass that reads the blocks by itself - see fillBuffer.
+    BufferedReader() = default;
+
+  public:
+    BufferedReader(const BufferedReader &other) = delete;
+
+  public:
+    BufferedReader &operator=(const BufferedReader &other) = delete;
+
+  protected:
+    void initBuffer(unsigned long bufferSize) {
+        if (bufferSize < 1) {
+            throw std::invalid_argument(BUFFER_SIZE_MESSAGE);
+        }
+        _buffer     = std::unique_ptr<char[]>(new char[bufferSize]);
+        _bufferSize = bufferSize;
+        _position   = _buffer.get();
+        _end        = _buffer.get();
+    }
+
+  public:
+    /// @return the amount of bytes read from the input so far.
+    unsigned long getBytesRead() const { return _bytesRead; }
+
+  public:
+    /**
+     * @return `true` if the end of the input was reached, *and* all of the
+     *         input was already returned. Else, `false`.
+     */
+    bool isEndOfInput() const { return _isEndOfInput && (_position == _end); }
+
+  public:
+    /**
+     * @return `true` if there is input that was already read from the input,
+     *         and not returned yet - so that returning it does not wait for
+     *         the input. Else, `false`.
+     */
+    bool hasBufferedInput() const { return _position != _end; }
+
+  public:
+    /// @return `true` if the input is a file-descriptor of a terminal.
+    bool isTerminal() const { return (_fd >= 0) && ::isatty(_fd); }
+
+  public:
+    /**
+     * @brief Gets the next line from the input - from the start of the
+     *        line until the @p endingChar char (not included).
+     *
+     * @note The last line of the input does not have to end with the
+     *       @p endingChar.
+     * @param line the line gotten. Set to an *empty* view when there are no
+     *             more lines.
+     * @param endingChar the char that ends each line.
+     * @return `true` if a line was gotten. `false` if the end of the input
+     *         was reached *before* a line was gotten.
+     * @throws std::runtime_error in case reading from the input failed.
+     */
+    bool getLine(std::string_view &line,
+                 char              endingChar = Constants::NEW_LINE) override {
+        bool isLineBuffered = false;
+        while (true) {
+            if ((_position == _end) && !fillBuffer()) {
+                if (!isLineBuffered) {
+                    line = std::string_view();
+                    return false;
+                }
+                line = _lineBuffer;
+                return true;
+            }
+
+            auto *found = (char *) std::memchr(_position, endingChar,
+                                               _end - _position);
+            if (found != nullptr) {
+                if (isLineBuffered) {
+                    _lineBuffer.append(_position, found - _position);
+                    line = _lineBuffer;
+                } else {
+                    line = std::string_view(_position, found - _position);
+                }
+                _position = found + 1;
+                return true;
+            }
+
+            // The line continues in the next block.
+            if (!isLineBuffered) {
+                _lineBuffer.clear();
+                isLineBuffered = true;
+            }
+            _lineBuffer.append(_position, _end - _position);
+            _position = _end;
+        }
+    }
+
+  public:
+    /**
+     * @brief Gets the next byte of the input, *without* consuming it.
+     * @return `true` if a byte was gotten. `false` on the end of the input.
+     * @throws std::runtime_error in case reading from the input failed.
+     */
+    bool peekByte(char &byte) {
+        if ((_position == _end) && !fillBuffer()) { return false; }
+        byte = *_position;
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Gets the next byte of the input.
+     * @return `true` if a byte was gotten. `false` on the end of the input.
+     * @throws std::runtime_error in case reading from the input failed.
+     */
+    bool readByte(char &byte) {
+        if ((_position == _end) && !fillBuffer()) { return false; }
+        byte = *_position++;
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Gets the next @p size bytes of the input - the same way as a
+     *        line of @link getLine @endlink.
+     *
+     * @param view the bytes gotten - valid *only* until the next call to
+     *             any method of `this` reader.
+     * @return `true` if all of the @p size bytes were gotten. `false` in case
+     *         the input ended before them.
+     * @throws std::runtime_error in case reading from the input failed.
+     */
+    bool readView(unsigned long size, std::string_view &view) {
+        if ((unsigned long) (_end - _position) >= size) {
+            view = std::string_view(_position, size);
+            _position += size;
+            return true;
+        }
+
+        // The bytes continue in the next blocks.
+        _lineBuffer.assign(_position, _end - _position);
+        _position = _end;
+        while (_lineBuffer.length() < size) {
+            if (!fillBuffer()) { return false; }
+
+            unsigned long length = std::min(size - _lineBuffer.length(),
+                                            (unsigned long) (_end - _position));
+            _lineBuffer.append(_position, length);
+            _position += length;
+        }
+        view = _lineBuffer;
+        return true;
+    }
+
+  protected:
+    /**
+     * @brief Reads the next block of the input into the `_buffer`.
+     * @return `true` if any bytes were read. `false` on the end of the input.
+     * @throws std::runtime_error in case reading from the input failed.
+     * @note a subclass may read the blocks some other way - by pointing the
+     *       `_position` and the `_end` to the next block, and by updating
+     *       the `_bytesRead` and the `_isEndOfInput`. A line that continues
+     *       in the next block was already copied to the `_lineBuffer` when
+     *       this method is called.
+     */
+    virtual bool fillBuffer() {
+        if (_isEndOfInput) { return false; }
+
+        long bytesRead = 0;
+        if (_streambuf != nullptr) {
+            bytesRead = (long) _streambuf->sgetn(_buffer.get(),
+                                                 (std::streamsize) _bufferSize);
+        } else {
+            do {
+                bytesRead = (long) ::read(_fd, _buffer.get(), _bufferSize);
+            } while ((bytesRead < 0) && (errno == EINTR));
+            if (bytesRead < 0) {
+                throw std::runtime_error(READ_ERROR_MESSAGE);
+            }
+        }
+
+        _position = _buffer.get();
+        _end      = _buffer.get() + bytesRead;
+
+        _bytesRead += bytesRead;
+        if (bytesRead == 0) { _isEndOfInput = true; }
+        return bytesRead > 0;
+    }
+};
+
+#endif // BUFFERED_READER_H
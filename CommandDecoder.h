@@ -0,0 +1,257 @@
+
+#ifndef COMMAND_DECODER_H
+#define COMMAND_DECODER_H
+
+#include "Constants.h"
+#include <climits>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @brief This class decodes each line of the input to a @link Command
+ *        @endlink - in a *single* pass over the line, and *without* any
+ *        heap allocation.
+ *
+ * The decoder accepts and rejects *exactly* the same lines that
+ * `Input::getTest` followed by `stoi` on the key accepts and rejects:
+ * @li The first line (index `0`) must be exactly `e`.
+ * @li Any other line must start with a letter between `a` and `g` that is
+ *     not `e`. Only the letter `f` may be followed by parameters.
+ * @li `f` must be followed by a *key* and a *value*, each after a single
+ *     ' '. The key must be an `int` - an optional sign followed by digits,
+ *     that does not overflow. The value is the rest of the line, and may
+ *     contain ' ' chars.
+ * @li As `Input` merges the split value back with a single ' ', a value
+ *     that ends with multiple ' ' chars keeps only the first of them - and a
+ *     value of only ' ' chars is empty.
+ *
+ * For example:
+ * @code
+ * CommandDecoder::Command command;
+ * CommandDecoder::decode("f 7 day hello hey", 1, command);
+ * // command.opcode == 'f', command.key == 7, command.value == "day hello hey"
+ * @endcode
+ *
+ * @see Input::getTest
+ * @version 1.0
+ */
+class CommandDecoder {
+
+  public:
+    /**
+     * @brief A decoded line of the input.
+     *
+     * @note the `value` *views* the line that was decoded - so it is valid
+     *       only as long as the line is.
+     */
+    struct Command {
+
+        /// The letter of the method to invoke, between `a` and `g`.
+        char opcode = 0;
+
+        /// The *key* to insert. Set only when the `opcode` is `f`.
+        int key = 0;
+
+        /// The *value* to insert. Set only when the `opcode` is `f`.
+        std::string_view value;
+    };
+
+  public:
+    /// The letter which must be the only letter of the first line.
+    static constexpr char FIRST_LETTER = 'e';
+
+  public:
+    /// The letter which after it the user needs to provide 2 parameters.
+    static constexpr char ALLOWED_TWO_PARAMETERS_LETTER = 'f';
+
+  public:
+    /// The minimum letter which is valid to be inputted.
+    static constexpr char MINIMUM_LETTER = 'a';
+
+  public:
+    /// The maximum letter which is valid to be inputted.
+    static constexpr char MAXIMUM_LETTER = 'g';
+
+  public:
+    /// The char that separates the letter and the parameters of a line.
+    static constexpr char DELIMITER = ' ';
+
+  public:
+    /**
+     * @brief Decodes the given @p line to the given @p command.
+     *
+     * @param line a *non-empty* line of the input.
+     * @param index the index of the @p line, among the lines after the
+     *              number of lines declared.
+     * @param command the command decoded.
+     * @throws std::runtime_error in case the @p line is not valid.
+     */
+    static void decode(std::string_view line, unsigned long index,
+                       Command &command) {
+        if (!tryDecode(line, index, command)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+    }
+
+  public:
+    /**
+     * @brief The same as @link decode @endlink above, with the @p keyEnd of
+     *        the @p line already known - for example, from the structural
+     *        index of a `StructuralLineReader`.
+     *
+     * @param keyEnd the index of the first ' ' char in the @p line, *after*
+     *               its first two chars. `std::string_view::npos` in case
+     *               there is no such char.
+     * @throws std::runtime_error in case the @p line is not valid.
+     */
+    static void decode(std::string_view line, unsigned long index,
+                       Command &command, unsigned long keyEnd) {
+        if (!tryDecode(line, index, command, keyEnd)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+    }
+
+  public:
+    /**
+     * @brief Decodes the given @p line to the given @p command.
+     *
+     * @return `true` if the @p line is valid. Else, `false` - and the
+     *         @p command is left unspecified.
+     * @see decode
+     */
+    static bool tryDecode(std::string_view line, unsigned long index,
+                          Command &command) noexcept {
+        return tryDecode(line, index, command, line.find(DELIMITER, 2));
+    }
+
+  public:
+    /**
+     * @brief Decodes the given @p line to the given @p command, with the
+     *        @p keyEnd of the @p line already known.
+     *
+     * @return `true` if the @p line is valid. Else, `false` - and the
+     *         @p command is left unspecified.
+     * @see decode(std::string_view, unsigned long, Command &, unsigned long)
+     */
+    static bool tryDecode(std::string_view line, unsigned long index,
+                          Command &command, unsigned long keyEnd) noexcept {
+        if (line.empty()) { return false; }
+
+        char letter    = line[0];
+        command.opcode = letter;
+        command.key    = 0;
+        command.value  = std::string_view();
+        if (index == 0) {
+            return (letter == FIRST_LETTER) && (line.length() == 1);
+        }
+
+        if ((letter < MINIMUM_LETTER) || (MAXIMUM_LETTER < letter) ||
+            (letter == FIRST_LETTER)) {
+            return false;
+        }
+        if (line.length() == 1) {
+
+            // `f` without parameters fails on getting its key.
+            return letter != ALLOWED_TWO_PARAMETERS_LETTER;
+        }
+        if ((line[1] != DELIMITER) ||
+            (letter != ALLOWED_TWO_PARAMETERS_LETTER)) {
+            return false;
+        }
+
+        // The key is between the first and the second delimiter.
+        if ((keyEnd == std::string_view::npos) || (keyEnd == 2)) {
+            return false;
+        }
+        if (!tryParseInt(line.substr(2, keyEnd - 2), command.key)) {
+            return false;
+        }
+
+        command.value = getValue(line.substr(keyEnd + 1));
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Decodes the first line of the input - the number of lines
+     *        declared.
+     *
+     * The same as `Input::getValidNumberOfTestsDeclared`: the line must
+     * contain only digits, that represent a positive `long`.
+     * @param line the first line of the input.
+     * @return the number of lines declared.
+     * @throws std::runtime_error in case the @p line is not valid.
+     */
+    static unsigned long decodeNumberOfCommands(std::string_view line) {
+        if (line.empty()) { throw std::runtime_error(Constants::WRONG_INPUT); }
+
+        unsigned long numberOfCommands = 0;
+        for (char c : line) {
+            if (!isDigit(c)) {
+                throw std::runtime_error(Constants::WRONG_INPUT);
+            }
+            numberOfCommands = numberOfCommands * 10 + (c - '0');
+            if (numberOfCommands > (unsigned long) LONG_MAX) {
+                throw std::runtime_error(Constants::WRONG_INPUT);
+            }
+        }
+
+        if (numberOfCommands < 1) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+        return numberOfCommands;
+    }
+
+  public:
+    /**
+     * @brief Parses an `int` - an optional sign followed by *at least* one
+     *        digit.
+     *
+     * @param str the string to parse.
+     * @param result the `int` parsed.
+     * @return `true` if the @p str is a valid `int` that does not overflow.
+     *         Else, `false`.
+     */
+    static bool tryParseInt(std::string_view str, int &result) noexcept {
+        unsigned long i          = 0;
+        bool          isNegative = false;
+        if (!str.empty() && ((str[0] == '+') || (str[0] == '-'))) {
+            isNegative = str[0] == '-';
+            i++;
+        }
+        if (i == str.length()) { return false; }
+
+        // `INT_MIN`'s magnitude is larger by `1` than `INT_MAX`'s.
+        long maximumMagnitude = (long) INT_MAX + (isNegative ? 1 : 0);
+        long magnitude        = 0;
+        for (; i < str.length(); i++) {
+            if (!isDigit(str[i])) { return false; }
+            magnitude = magnitude * 10 + (str[i] - '0');
+            if (magnitude > maximumMagnitude) { return false; }
+        }
+
+        result = (int) (isNegative ? -magnitude : magnitude);
+        return true;
+    }
+
+  protected:
+    /**
+     * @return the value of an `f` line, out of the @p rest of the line after
+     *         the key - as merged by `Input`.
+     */
+    static std::string_view getValue(std::string_view rest) {
+        unsigned long lastNonDelimiter = rest.find_last_not_of(DELIMITER);
+        if (lastNonDelimiter == std::string_view::npos) {
+            return std::string_view();
+        }
+        if (lastNonDelimiter + 1 == rest.length()) { return rest; }
+
+        // Keep only the first of the trailing delimiters.
+        return rest.substr(0, lastNonDelimiter + 2);
+    }
+
+  protected:
+    static bool isDigit(char c) { return ('0' <= c) && (c <= '9'); }
+};
+
+#endif // COMMAND_DECODER_H
@@ -0,0 +1,144 @@
+
+#ifndef COMMAND_STATISTICS_H
+#define COMMAND_STATISTICS_H
+
+#include "CommandDecoder.h"
+#include "HeapStatistics.h"
+#include "LatencyHistogram.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+
+/**
+ * @brief The latencies of the "tests" that the program ran - a
+ *        `LatencyHistogram` of the execution of each letter, and of the
+ *        parsing and the output of the "tests" - in ns.
+ *
+ * For example:
+ * @code
+ * CommandStatistics statistics;
+ * TestRunner::Options options;
+ * options.statistics = &statistics;
+ * TestRunner::getTestArrayAndRunAllTests(options);
+ * statistics.print(std::cerr);
+ * @endcode
+ *
+ * @see TestRunner::Options::statistics
+ * @version 1.0
+ */
+class CommandStatistics {
+
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+  protected:
+    /// The amount of letters - from `CommandDecoder::MINIMUM_LETTER`.
+    static constexpr unsigned long LETTER_COUNT =
+            CommandDecoder::MAXIMUM_LETTER - CommandDecoder::MINIMUM_LETTER +
+            1;
+
+  protected:
+    /// The name of the method of each letter - from `a`.
+    static constexpr const char *METHOD_NAMES[LETTER_COUNT] = {
+            "max", "deleteMax", "min", "deleteMin", "createEmpty", "insert",
+            "median"};
+
+  protected:
+    /// The execution latency of each letter - from `a`.
+    std::unique_ptr<LatencyHistogram[]> _executions;
+
+  protected:
+    /// The latency of parsing each "test" - including reading its line.
+    LatencyHistogram _parsing;
+
+  protected:
+    /// The latency of writing each result.
+    LatencyHistogram _outputs;
+
+  protected:
+    /**
+     * The counters of the internal operations of the `PriorityQueueKv` -
+     * printed only when built with `HEAP_STATISTICS`.
+     */
+    HeapStatistics _heapStatistics;
+
+  public:
+    CommandStatistics() : _executions(new LatencyHistogram[LETTER_COUNT]) {}
+
+  public:
+    /// @return the nanoseconds of the given @p duration.
+    static unsigned long toNanoseconds(Clock::duration duration) {
+        return (unsigned long) std::chrono::nanoseconds(duration).count();
+    }
+
+  public:
+    /// @brief Records the execution of a "test" of the given @p letter.
+    void recordExecution(char letter, Clock::duration duration) {
+        _executions[letter - CommandDecoder::MINIMUM_LETTER].record(
+                toNanoseconds(duration));
+    }
+
+  public:
+    void recordParsing(Clock::duration duration) {
+        _parsing.record(toNanoseconds(duration));
+    }
+
+  public:
+    void recordOutput(Clock::duration duration) {
+        _outputs.record(toNanoseconds(duration));
+    }
+
+  public:
+    void setHeapStatistics(const HeapStatistics &heapStatistics) {
+        _heapStatistics = heapStatistics;
+    }
+
+  public:
+    /**
+     * @brief Prints a summary of all the latencies - the count, the mean,
+     *        the 50th, 90th, 99th and 99.9th percentiles and the maximum of
+     *        each, and their total time.
+     */
+    void print(std::ostream &os) const {
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "%-14s %12s %10s %10s %10s %10s %10s %12s %12s\n",
+                      "latency (ns)", "count", "mean", "p50", "p90", "p99",
+                      "p999", "max", "total (ms)");
+        os << line;
+        for (unsigned long i = 0; i < LETTER_COUNT; i++) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%c %s",
+                          (char) (CommandDecoder::MINIMUM_LETTER + i),
+                          METHOD_NAMES[i]);
+            printHistogram(os, name, _executions[i]);
+        }
+        printHistogram(os, "parse", _parsing);
+        printHistogram(os, "output", _outputs);
+        if (HeapStatistics::IS_ENABLED) { os << _heapStatistics << "\n"; }
+        os.flush();
+    }
+
+  protected:
+    /// @brief Prints a single line of the summary - unless it is empty.
+    static void printHistogram(std::ostream &os, const char *name,
+                               const LatencyHistogram &histogram) {
+        if (histogram.getCount() == 0) { return; }
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "%-14s %12lu %10.0f %10lu %10lu %10lu %10lu %12lu "
+                      "%12.3f\n",
+                      name, histogram.getCount(), histogram.getMean(),
+                      histogram.getValueAtPercentile(50),
+                      histogram.getValueAtPercentile(90),
+                      histogram.getValueAtPercentile(99),
+                      histogram.getValueAtPercentile(99.9),
+                      histogram.getMaximum(),
+                      histogram.getMean() * (double) histogram.getCount() /
+                              1e6);
+        os << line;
+    }
+};
+
+#endif // COMMAND_STATISTICS_H
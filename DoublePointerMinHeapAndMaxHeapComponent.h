@@ -2,10 +2,15 @@
 #ifndef DOUBLE_POINTER_MIN_HEAP_AND_MAX_HEAP_COMPONENT_H
 #define DOUBLE_POINTER_MIN_HEAP_AND_MAX_HEAP_COMPONENT_H
 
+#include "BasicAllocations.h"
 #include "MaxHeap.h"
 #include "MaxHeapWhenAlsoHavingMinHeap.h"
+#include "MemoryUsage.h"
 #include "MinHeapWhenAlsoHavingMaxHeap.h"
+#include "NodePool.h"
+#include <memory>
 #include <ostream>
+#include <type_traits>
 
 /**
  * @brief This class contains two `Heap`s, that share a mutual
@@ -15,60 +20,213 @@
  *        `ElementInMinHeapAndMaxHeap`.
  *
  * @note `ElementInMinHeapAndMaxHeap<E>` will be also be referred as `EWrapper`.
+ * @tparam Allocator a std-allocator compatible allocator, that both heaps
+ *                   and every `EWrapperNode` are allocated with - unless an
+ *                   `EWrapperNodePool` is given, in which case the nodes are
+ *                   allocated from it.
  * @see MinHeapWhenAlsoHavingMaxHeap
  * @see MaxHeapWhenAlsoHavingMinHeap
  * @see ElementInMinHeapAndMaxHeap
  */
-template<typename E> class DoublePointerMinHeapAndMaxHeapComponent {
+template<typename E, typename Allocator = std::allocator<E>>
+class DoublePointerMinHeapAndMaxHeapComponent {
 
     typedef ElementInMinHeapAndMaxHeap<E> EWrapper;
 
+  public:
+    /**
+     * @brief The *node* allocated for each element inserted to both heaps.
+     *
+     * A node bundles the `element` itself, the `Unique` that points to it,
+     * and the `EWrapper` that points to that `Unique` - so that each
+     * element inserted costs a *single* allocation via the `Allocator`,
+     * instead of three separate `new`s.
+     *
+     * @note The node *is-a* `EWrapper`, so the heaps keep storing plain
+     *       `EWrapper` pointers, and a node is reached back from an
+     *       `EWrapper` by a `static_cast`.
+     * @note The `EWrapper` base is constructed with the *address* of
+     *       `_unique`, before `_unique` itself is constructed. This is okay,
+     *       because the address is only stored, and not dereferenced.
+     */
+    class EWrapperNode : public EWrapper {
+
+      protected:
+        E _element;
+
+      protected:
+        Unique<E> _unique;
+
+      public:
+        explicit EWrapperNode(E &&element)
+            : EWrapper(&_unique), _element((E &&) element), _unique(&_element) {
+        }
+    };
+
+  public:
+    /**
+     * @brief A pool of `EWrapperNode`s, that may be *shared* between
+     *        components - so that their nodes can be all released at once.
+     * @see NodePool
+     */
+    typedef NodePool<EWrapperNode,
+                     BasicAllocations::Rebind<EWrapperNode, Allocator>>
+            EWrapperNodePool;
+
   protected:
-    MinHeapWhenAlsoHavingMaxHeap<E> *minHeap = nullptr;
+    /// The allocator that the heaps and the nodes are allocated with.
+    Allocator _allocator;
 
   protected:
-    MaxHeapWhenAlsoHavingMinHeap<E> *maxHeap = nullptr;
+    /**
+     * The pool that the nodes are allocated from. Not owned by `this`
+     * component. In case it is `nullptr`, the nodes are allocated
+     * with the `_allocator` instead.
+     */
+    EWrapperNodePool *_nodePool = nullptr;
+
+  protected:
+    MinHeapWhenAlsoHavingMaxHeap<E, Allocator> *minHeap = nullptr;
+
+  protected:
+    MaxHeapWhenAlsoHavingMinHeap<E, Allocator> *maxHeap = nullptr;
 
   public:
-    DoublePointerMinHeapAndMaxHeapComponent(
-            MinHeapWhenAlsoHavingMaxHeap<E> *minHeap,
-            MaxHeapWhenAlsoHavingMinHeap<E> *maxHeap)
-        : minHeap(minHeap), maxHeap(maxHeap) {}
+    /**
+     * @brief Constructor, allocates both heaps via the given @p allocator.
+     *
+     * @param physicalSize the *physical-size* of each of the heaps.
+     * @param allocator the allocator to allocate the heaps and the nodes
+     *                  with.
+     * @param nodePool a pool to allocate the nodes from, that outlives
+     *                 `this` component. May be `nullptr`.
+     */
+    explicit DoublePointerMinHeapAndMaxHeapComponent(
+            unsigned long     physicalSize,
+            const Allocator & allocator = Allocator(),
+            EWrapperNodePool *nodePool  = nullptr)
+        : _allocator(allocator), _nodePool(nodePool) {
+        minHeap = BasicAllocations::create<
+                MinHeapWhenAlsoHavingMaxHeap<E, Allocator>>(
+                _allocator, physicalSize, _allocator);
+        maxHeap = BasicAllocations::create<
+                MaxHeapWhenAlsoHavingMinHeap<E, Allocator>>(
+                _allocator, physicalSize, _allocator);
+    }
 
   public:
     virtual ~DoublePointerMinHeapAndMaxHeapComponent() { deleteThis(); }
 
   protected:
     void deleteThis() const {
+        makeEmpty();
+        BasicAllocations::destroy(_allocator, minHeap);
+        BasicAllocations::destroy(_allocator, maxHeap);
+    }
 
-        while (!minHeap->isEmpty()) {
-
-            /**
-             * - Delete the root from `minHeap`.
-             * - Delete its pointer at `maxHeap`.
-             * - Delete the EWrapper containing the indexes of `minHeap` and `maxHeap`.
-             */
-            deleteEWrapperFromBothHeapsViaIndexOfMinHeapElement(0, true);
+  public:
+    /**
+     * @brief Removes all the `EWrapper`s from both heaps, and `delete`s them.
+     *        Both heaps keep their arrays, so that they can be filled again
+     *        without any reallocation.
+     *
+     * @note The heaps are not fixed while removing, as all the elements are
+     *       removed - so this method is `O(n)`.
+     *       Moreover, in case the nodes are allocated from an
+     *       `EWrapperNodePool` and `E` is *trivially destructible*, there is
+     *       no need to visit each node, so this method is `O(1)`.
+     * @attention in the `O(1)` case the storage of the nodes is *not*
+     *            returned to the `EWrapperNodePool`, and is reclaimed only by
+     *            `EWrapperNodePool::release()` - which the owner of the pool
+     *            is expected to invoke afterwards.
+     * @see EWrapperNodePool
+     */
+    void makeEmpty() const {
+        bool isNeedToVisitEachNode = (_nodePool == nullptr) ||
+                                     !std::is_trivially_destructible<E>::value;
+        if (isNeedToVisitEachNode) {
+            for (unsigned long i = 0; i < minHeap->getLogicalSize(); i++) {
+                destroyEWrapper(minHeap->getElement(i));
+            }
         }
 
-        delete minHeap;
-        delete maxHeap;
+        minHeap->makeEmpty();
+        maxHeap->makeEmpty();
+    }
+
+  public:
+    MinHeapWhenAlsoHavingMaxHeap<E, Allocator> *getMinHeap() {
+        return minHeap;
     }
 
   public:
-    MinHeapWhenAlsoHavingMaxHeap<E> *getMinHeap() { return minHeap; }
+    MaxHeapWhenAlsoHavingMinHeap<E, Allocator> *getMaxHeap() {
+        return maxHeap;
+    }
 
   public:
-    MaxHeapWhenAlsoHavingMinHeap<E> *getMaxHeap() { return maxHeap; }
+    /**
+     * @return the counters of the operations of *both* heaps so far.
+     * @see Heap::getStatistics
+     */
+    HeapStatistics getStatistics() const {
+        HeapStatistics statistics = minHeap->getStatistics();
+        statistics += maxHeap->getStatistics();
+        return statistics;
+    }
 
   public:
     /**
-     * @brief "wraps" a given @p element with an `EWrapper`, and inserts it
-     *        to both heaps.
-     * @param element an element to be "wrapped" with an `EWrapper` to insert.
+     * @return the bytes held by both heaps and by their elements - in
+     *         `O(n)`, as each element is visited for the bytes that its key
+     *         and its value allocate.
+     * @note the nodes are counted by their own size, whether they were
+     *       allocated from the `EWrapperNodePool` or not - so the part of
+     *       the pool not in use is not counted here.
+     * @see MemoryUsage
+     */
+    MemoryUsage getMemoryUsage() const {
+        MemoryUsage   memoryUsage;
+        unsigned long count = minHeap->getLogicalSize();
+        memoryUsage.heapArrayBytes =
+                (minHeap->getPhysicalSize() + maxHeap->getPhysicalSize()) *
+                sizeof(EWrapper *);
+        memoryUsage.heapArraySlackBytes =
+                (minHeap->getPhysicalSize() - count +
+                 maxHeap->getPhysicalSize() - maxHeap->getLogicalSize()) *
+                sizeof(EWrapper *);
+        memoryUsage.wrapperBytes = count * sizeof(EWrapper);
+        memoryUsage.uniqueBytes  = count * sizeof(Unique<E>);
+        memoryUsage.entryBytes =
+                count * (sizeof(EWrapperNode) - sizeof(EWrapper) -
+                         sizeof(Unique<E>));
+        for (unsigned long i = 0; i < count; i++) {
+            const E *element =
+                    minHeap->getElement(i)->getUniqueElement()->getElement();
+            memoryUsage.keyAndValueBytes +=
+                    MemoryUsage::getAllocatedBytes(
+                            element->getKeyReference()) +
+                    MemoryUsage::getAllocatedBytes(
+                            element->getValueReference());
+        }
+        memoryUsage.otherBytes =
+                sizeof(*this) + sizeof(*minHeap) + sizeof(*maxHeap);
+        return memoryUsage;
+    }
+
+  public:
+    /**
+     * @brief "wraps" a given @p element with an `EWrapperNode`, and inserts
+     *        it to both heaps.
+     * @param element an element to be "wrapped" with an `EWrapperNode` to
+     *                insert.
      */
     void insertToBothHeaps(E &&element) {
-        auto *eWrapper = new EWrapper((E &&) element);
+        EWrapper *eWrapper =
+                _nodePool != nullptr
+                        ? _nodePool->create((E &&) element)
+                        : BasicAllocations::create<EWrapperNode>(
+                                  _allocator, (E &&) element);
         insertToBothHeaps(eWrapper);
     }
 
@@ -108,7 +266,7 @@ template<typename E> class DoublePointerMinHeapAndMaxHeapComponent {
         if (deleteEWrapper) {
 
             // `delete` the `EWrapper` from memory.
-            delete eWrapperToDelete;
+            destroyEWrapper(eWrapperToDelete);
             eWrapperToDelete = nullptr;
         } else {
             eWrapperToDelete->setMaxHeapIndex(0); // Reset index.
@@ -144,7 +302,7 @@ template<typename E> class DoublePointerMinHeapAndMaxHeapComponent {
         if (deleteEWrapper) {
 
             // `delete` the `EWrapper` from memory.
-            delete eWrapperToDelete;
+            destroyEWrapper(eWrapperToDelete);
             eWrapperToDelete = nullptr;
         } else {
             eWrapperToDelete->setMaxHeapIndex(0); // Reset index.
@@ -154,6 +312,25 @@ template<typename E> class DoublePointerMinHeapAndMaxHeapComponent {
         return eWrapperToDelete;
     }
 
+  protected:
+    /**
+     * @brief Destroys the `EWrapperNode` of the given @p eWrapper, including
+     *        the `element` within it, via the `EWrapperNodePool` or else the
+     *        `Allocator`.
+     *
+     * @attention the given @p eWrapper *must* have been created by
+     *            @link insertToBothHeaps(E &&) @endlink of a component
+     *            with an *equal* `Allocator` and the same `EWrapperNodePool`.
+     */
+    void destroyEWrapper(EWrapper *eWrapper) const {
+        auto *node = static_cast<EWrapperNode *>(eWrapper);
+        if (_nodePool != nullptr) {
+            _nodePool->destroy(node);
+        } else {
+            BasicAllocations::destroy(_allocator, node);
+        }
+    }
+
   public:
     friend std::ostream &
     operator<<(std::ostream &                                 os,
@@ -170,7 +347,7 @@ template<typename E> class DoublePointerMinHeapAndMaxHeapComponent {
   private:
     static std::ostream &
     printThis(std::ostream &os,
-              const DoublePointerMinHeapAndMaxHeapComponent<E>
+              const DoublePointerMinHeapAndMaxHeapComponent<E, Allocator>
                       &doublePointerMinHeapAndMaxHeapComponent) {
         os << "---------------------------- ";
         os << "minHeap:";
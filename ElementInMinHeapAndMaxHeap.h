@@ -2,6 +2,7 @@
 #ifndef ELEMENT_IN_MIN_HEAP_AND_MAX_HEAP_H
 #define ELEMENT_IN_MIN_HEAP_AND_MAX_HEAP_H
 
+#include "Unique.h"
 #include <ostream>
 
 /**
@@ -18,6 +19,13 @@ template<typename E> class ElementInMinHeapAndMaxHeap {
   protected:
     Unique<E> *_uniqueElement = nullptr;
 
+  protected:
+    /**
+     * Tells whether `this` wrapper owns the `_uniqueElement`, and thus
+     * needs to `delete` it on destruction.
+     */
+    bool _needToDeleteUniqueElement = true;
+
   protected:
     long int _maxHeapIndex = 0;
 
@@ -34,9 +42,19 @@ template<typename E> class ElementInMinHeapAndMaxHeap {
         _uniqueElement = new Unique<E>((E &&) element);
     }
 
+  public:
+    /**
+     * @param uniqueElement an *already-created* `Unique` to wrap.
+     *                      No extra allocation is needed, and the
+     *                      @p uniqueElement is *not* owned by `this` wrapper -
+     *                      so its creator is responsible of destroying it.
+     */
+    explicit ElementInMinHeapAndMaxHeap(Unique<E> *uniqueElement)
+        : _uniqueElement(uniqueElement), _needToDeleteUniqueElement(false) {}
+
   public:
     virtual ~ElementInMinHeapAndMaxHeap() {
-        delete _uniqueElement;
+        if (_needToDeleteUniqueElement) { delete _uniqueElement; }
     }
 
   public:
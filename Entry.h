@@ -15,7 +15,7 @@
  * @attention the `key` **must** be `comparable`.
  * @tparam K the type of *key* in the entry.
  * @tparam V the type of *value* in the entry.
- * @version 1.0.2
+ * @version 1.0.6
  */
 template<typename K, typename V> class Entry {
 
@@ -31,29 +31,58 @@ template<typename K, typename V> class Entry {
     /**
      * @brief Initializer constructor.
      *
+     * @note the @p key and the @p value are *moved* into the entry - so
+     *       passing them as "rvalue"s does not copy them.
      * @param key the key to set the entry with.
      * @param value the value to set the entry with.
      */
-    Entry(K key, V value) {
-        this->_key   = key;
-        this->_value = value;
-    }
+    Entry(K key, V value) : _key((K &&) key), _value((V &&) value) {}
 
   public:
     Entry() = default;
 
   public:
-    virtual ~Entry() = default;
+    Entry(const Entry &other) = default;
+
+  public:
+    /**
+     * @note Declared explicitly, since the declared destructor below would
+     *       otherwise make moving an entry *copy* its key and value.
+     */
+    Entry(Entry &&other) noexcept = default;
+
+  public:
+    Entry &operator=(const Entry &other) = default;
+
+  public:
+    Entry &operator=(Entry &&other) noexcept = default;
+
+  public:
+    /**
+     * @note Not `virtual` on purpose, since `Entry` is not meant to be
+     *       inherited. This way, an `Entry` of *trivially destructible* `K`
+     *       and `V` is itself *trivially destructible*, and a `PriorityQueueKv`
+     *       of such entries can be emptied in `O(1)`.
+     */
+    ~Entry() = default;
 
   public:
     K getKey() const { return _key; }
 
+  public:
+    /// @return the *key* of the entry - *without* copying it.
+    const K &getKeyReference() const { return _key; }
+
   public:
     void setKey(K key) { this->_key = key; }
 
   public:
     V getValue() const { return _value; }
 
+  public:
+    /// @return the *value* of the entry - *without* copying it.
+    const V &getValueReference() const { return _value; }
+
   public:
     void setValue(V value) { this->_value = value; }
 
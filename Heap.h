@@ -3,8 +3,12 @@
 #define HEAP_H
 
 #include "BasicAlgorithms.h"
+#include "BasicAllocations.h"
 #include "HeapAdt.h"
+#include "HeapStatistics.h"
+#include "Tracepoints.h"
 #include <cmath>
+#include <memory>
 
 /**
  * @note The term `<<predicate-resulted>>` is a result of a predicate method
@@ -13,9 +17,12 @@
  *       `<<predicate-resulted>>` is defined to be the result of the
  *       @link predicateIsSwapNeeded(E, E) @endlink method.
  * @tparam E the type of each `element`.
+ * @tparam Allocator a std-allocator compatible allocator, that the `_array`
+ *                   is allocated with. Rebound to `E *` internally.
  * @see HeapAdt
  */
-template<typename E> class Heap : public HeapAdt<E> {
+template<typename E, typename Allocator = std::allocator<E>>
+class Heap : public HeapAdt<E> {
 
   protected:
     static constexpr char *IS_EMPTY_MESSAGE = (char *) "Heap: heap is empty.";
@@ -42,6 +49,10 @@ template<typename E> class Heap : public HeapAdt<E> {
      */
     E **_array = nullptr;
 
+  protected:
+    /// The allocator that the `_array` is allocated with.
+    Allocator _allocator;
+
   protected:
     /// The *physical-size* of the `_array`. Initialized to `0`.
     unsigned long _physicalSize = 0;
@@ -50,9 +61,39 @@ template<typename E> class Heap : public HeapAdt<E> {
     /// The *logical-size* of the `_array`. Initialized to `0`.
     unsigned long _logicalSize = 0;
 
+  protected:
+    /**
+     * The counters of the operations of this heap - counted only when built
+     * with `HEAP_STATISTICS`. Else, it is `static` - see
+     * `HeapStatisticsCounter`.
+     * @see getStatistics
+     */
+#ifdef HEAP_STATISTICS
+    HeapStatisticsCounter _statisticsCounter;
+#else
+    static constexpr HeapStatisticsCounter _statisticsCounter {};
+#endif
+
   public:
     unsigned long getLogicalSize() const override { return _logicalSize; }
 
+  public:
+    /// @return the amount of elements that the `_array` has room for.
+    unsigned long getPhysicalSize() const { return _physicalSize; }
+
+  public:
+    /**
+     * @return the counters of the comparisons, the swaps, the index writes
+     *         and the sifts of this heap so far - all `0` unless built with
+     *         `HEAP_STATISTICS`.
+     * @see HeapStatistics
+     */
+    HeapStatistics getStatistics() const { return _statisticsCounter.get(); }
+
+  public:
+    /// @brief Sets all the counters of @link getStatistics @endlink to `0`.
+    void resetStatistics() { _statisticsCounter.reset(); }
+
   public:
     /**
      * @brief Constructor, initializes the `_array`.
@@ -64,9 +105,12 @@ template<typename E> class Heap : public HeapAdt<E> {
      *                         heap from.
      * @param sizeOfArrayToBuildFrom the size of the array to build the
      *                               heap from.
+     * @param allocator the allocator to allocate the `_array` with.
      * @see buildHeap
      */
-    Heap(E *arrayToBuildFrom, unsigned long sizeOfArrayToBuildFrom) {
+    Heap(E *arrayToBuildFrom, unsigned long sizeOfArrayToBuildFrom,
+         const Allocator &allocator = Allocator())
+        : _allocator(allocator) {
         buildHeap(arrayToBuildFrom, sizeOfArrayToBuildFrom);
     }
 
@@ -77,10 +121,14 @@ template<typename E> class Heap : public HeapAdt<E> {
      *
      * @note the content of the `_array` remains empty.
      * @param physicalSize set the `_physicalSize` of the `_array` to be this size.
+     * @param allocator the allocator to allocate the `_array` with.
      */
-    explicit Heap(unsigned long physicalSize) {
+    explicit Heap(unsigned long   physicalSize,
+                  const Allocator &allocator = Allocator())
+        : _allocator(allocator) {
         this->_physicalSize = physicalSize;
-        this->_array        = new E *[physicalSize];
+        this->_array        = BasicAllocations::allocateArray<E *>(_allocator,
+                                                               physicalSize);
         for (unsigned long i = 0; i < _physicalSize; i++) {
             _array[i] = nullptr;
         }
@@ -96,7 +144,10 @@ template<typename E> class Heap : public HeapAdt<E> {
     virtual ~Heap() { deleteThis(); }
 
   private:
-    void deleteThis() { delete[] _array; }
+    void deleteThis() {
+        BasicAllocations::deallocateArray(_allocator, _array, _physicalSize);
+        _array = nullptr;
+    }
 
   public:
     /**
@@ -263,7 +314,8 @@ template<typename E> class Heap : public HeapAdt<E> {
         /* Initialize a `new` empty _array of pointers to elements given. */
         this->_physicalSize = sizeOfArrayToBuildFrom;
         this->_logicalSize  = sizeOfArrayToBuildFrom;
-        this->_array        = new E *[sizeOfArrayToBuildFrom];
+        this->_array        = BasicAllocations::allocateArray<E *>(
+                _allocator, sizeOfArrayToBuildFrom);
         for (unsigned long i = 0; i < sizeOfArrayToBuildFrom; i++) {
             this->_array[i] = &arrayToBuildFrom[i];
         }
@@ -271,10 +323,11 @@ template<typename E> class Heap : public HeapAdt<E> {
         /*
          * `currentIndex` should be in between `0` and `(_logicalSize / 2)`.
          * Note: the almost last level has `(_logicalSize / 2)` `nodes`.
+         * Note: `currentIndex` is unsigned, so it is decreased *before* each
+         *       iteration - as `currentIndex >= 0` would never be `false`.
          */
-        unsigned long lastIndex = this->_logicalSize - 1;
-        for (unsigned long currentIndex = getParentIndex(lastIndex);
-             currentIndex >= 0; currentIndex--) {
+        for (unsigned long currentIndex = this->_logicalSize / 2;
+             currentIndex-- > 0;) {
             fixHeap(currentIndex);
         }
     }
@@ -423,6 +476,7 @@ template<typename E> class Heap : public HeapAdt<E> {
      * @see Direction
      */
     void fixHeapWhile(unsigned long currentIndex, Direction direction) {
+        unsigned long depth = 0;
 
         /* `_array[currentIndex]` is not `nullptr`. Thus, comparable. */
         while ((0 <= currentIndex) && (currentIndex < (_logicalSize / 2))) {
@@ -432,6 +486,11 @@ template<typename E> class Heap : public HeapAdt<E> {
                     getIndexOfChildToSwapWithParent(_array, _logicalSize,
                                                     currentIndex * 2 + 1,
                                                     currentIndex * 2 + 2);
+            if (currentIndex * 2 + 2 < _logicalSize) {
+
+                // The two children were compared to each other.
+                _statisticsCounter.count(&HeapStatistics::comparisonCount);
+            }
             if (_array[indexOfSwappableChildOfCurrentRoot] != nullptr) {
 
                 /*
@@ -440,11 +499,14 @@ template<typename E> class Heap : public HeapAdt<E> {
                  * `swap` the elements if needed, to maintain the validity of
                  * the heap as a `Heap`.
                  */
+                _statisticsCounter.count(&HeapStatistics::comparisonCount);
                 if (predicateIsSwapNeeded(
                             _array[currentIndex],
                             _array[indexOfSwappableChildOfCurrentRoot])) {
+                    _statisticsCounter.count(&HeapStatistics::swapCount);
                     onSwapIsNeeded(currentIndex,
                                    indexOfSwappableChildOfCurrentRoot);
+                    depth++;
 
                     /*
                      * Set the updated iterator index to the replaced index.
@@ -473,6 +535,9 @@ template<typename E> class Heap : public HeapAdt<E> {
                 break;
             }
         }
+        _statisticsCounter.countSift(depth);
+        PRIORITY_QUEUE_KV_TRACE(sift, depth, _logicalSize,
+                                (int) (direction == Direction::UPWARDS));
     }
 
   protected:
@@ -564,6 +629,7 @@ template<typename E> class Heap : public HeapAdt<E> {
          * elements according to the insertion, to ensure the heap is valid.
          * While there is at least `1` child in the _array.
          */
+        unsigned long depth = 0;
         while (0 < currentIndex) {
 
             /*
@@ -571,10 +637,13 @@ template<typename E> class Heap : public HeapAdt<E> {
              * its parent, to check if there is a need to `swap` between
              * them, in order to ensure validity of the heap, as a `Heap`.
              */
+            _statisticsCounter.count(&HeapStatistics::comparisonCount);
             if (predicateIsSwapNeeded(
                         this->_array[getParentIndex(currentIndex)],
                         this->_array[currentIndex])) {
+                _statisticsCounter.count(&HeapStatistics::swapCount);
                 onSwapIsNeeded(getParentIndex(currentIndex), currentIndex);
+                depth++;
 
                 /* Step upwards to the parent of the element. */
                 currentIndex = getParentIndex(currentIndex);
@@ -584,6 +653,8 @@ template<typename E> class Heap : public HeapAdt<E> {
                 break;
             }
         }
+        _statisticsCounter.countSift(depth);
+        PRIORITY_QUEUE_KV_TRACE(sift, depth, this->_logicalSize, 1);
     }
 
   public:
@@ -610,7 +681,8 @@ template<typename E> class Heap : public HeapAdt<E> {
     }
 
   private:
-    static std::ostream &printThis(std::ostream &os, const Heap<E> &heap) {
+    static std::ostream &printThis(std::ostream &              os,
+                                   const Heap<E, Allocator> &heap) {
         os << "_array{\n";
 
         /* In case the _array is empty, print a message instead of elements. */
@@ -0,0 +1,174 @@
+
+#ifndef HEAP_STATISTICS_H
+#define HEAP_STATISTICS_H
+
+#include <algorithm>
+#include <ostream>
+
+/**
+ * @brief The counters of the internal operations of the heaps, of the
+ *        `PriorityQueueKv` and of the `NodePool` - to tell *why* a workload
+ *        is slow.
+ *
+ * The counters are counted only when the program is built with
+ * `HEAP_STATISTICS` defined - for example, configured with
+ * `-DHEAP_STATISTICS=ON`. Else, they are all `0`, and counting them costs
+ * nothing.
+ *
+ * For example:
+ * @code
+ * PriorityQueueKv<int, std::string> priorityQueueKv;
+ * ...
+ * std::cerr << priorityQueueKv.getStatistics() << std::endl;
+ * @endcode
+ *
+ * @see HeapStatisticsCounter
+ * @version 1.0
+ */
+struct HeapStatistics {
+
+    /// Whether the counters are counted - see `HEAP_STATISTICS`.
+#ifdef HEAP_STATISTICS
+    static constexpr bool IS_ENABLED = true;
+#else
+    static constexpr bool IS_ENABLED = false;
+#endif
+
+    /// The amount of comparisons between two elements.
+    unsigned long comparisonCount = 0;
+
+    /// The amount of swaps between two elements of a heap.
+    unsigned long swapCount = 0;
+
+    /**
+     * The amount of writes of the index of an element in a heap - by
+     * `onSwapIsNeeded` and by `onUpdateElementWithIndex`.
+     */
+    unsigned long indexWriteCount = 0;
+
+    /// The amount of times an element was *sifted* upwards or downwards.
+    unsigned long siftCount = 0;
+
+    /// The sum of the levels that all the sifted elements moved.
+    unsigned long siftLevelCount = 0;
+
+    /// The most levels that a single sifted element moved.
+    unsigned long maximumSiftDepth = 0;
+
+    /// `PriorityQueueKv::transferTheMaxElementFromLessToGreater` calls.
+    unsigned long transferFromLessToGreaterCount = 0;
+
+    /// `PriorityQueueKv::transferTheMinElementFromGreaterToLess` calls.
+    unsigned long transferFromGreaterToLessCount = 0;
+
+    /// The amount of nodes created by a `NodePool`.
+    unsigned long nodeAllocationCount = 0;
+
+    /// The amount of blocks a `NodePool` allocated from its `Allocator`.
+    unsigned long blockAllocationCount = 0;
+
+    /// @brief Adds all the counters of the @p other statistics to these.
+    HeapStatistics &operator+=(const HeapStatistics &other) {
+        comparisonCount += other.comparisonCount;
+        swapCount += other.swapCount;
+        indexWriteCount += other.indexWriteCount;
+        siftCount += other.siftCount;
+        siftLevelCount += other.siftLevelCount;
+        maximumSiftDepth = std::max(maximumSiftDepth, other.maximumSiftDepth);
+        transferFromLessToGreaterCount += other.transferFromLessToGreaterCount;
+        transferFromGreaterToLessCount += other.transferFromGreaterToLessCount;
+        nodeAllocationCount += other.nodeAllocationCount;
+        blockAllocationCount += other.blockAllocationCount;
+        return *this;
+    }
+
+    /// @brief Prints each counter as `name: count`, one per line.
+    friend std::ostream &operator<<(std::ostream &        os,
+                                    const HeapStatistics &statistics) {
+        os << "comparisons: " << statistics.comparisonCount << "\n"
+           << "swaps: " << statistics.swapCount << "\n"
+           << "index writes: " << statistics.indexWriteCount << "\n"
+           << "sifts: " << statistics.siftCount << "\n"
+           << "sift levels: " << statistics.siftLevelCount << "\n"
+           << "maximum sift depth: " << statistics.maximumSiftDepth << "\n"
+           << "transfers from less to greater: "
+           << statistics.transferFromLessToGreaterCount << "\n"
+           << "transfers from greater to less: "
+           << statistics.transferFromGreaterToLessCount << "\n"
+           << "node allocations: " << statistics.nodeAllocationCount << "\n"
+           << "block allocations: " << statistics.blockAllocationCount;
+        return os;
+    }
+};
+
+/**
+ * @brief Counts `HeapStatistics` - only when built with `HEAP_STATISTICS`.
+ *        Else, this class is *empty*, and all of its methods do nothing.
+ *
+ * Without `HEAP_STATISTICS`, declare it as a `static constexpr` member,
+ * so that it takes no room in each object - a non-`static` empty member
+ * still takes a byte, and its padding:
+ * @code
+ * #ifdef HEAP_STATISTICS
+ *     HeapStatisticsCounter _statisticsCounter;
+ * #else
+ *     static constexpr HeapStatisticsCounter _statisticsCounter {};
+ * #endif
+ * @endcode
+ *
+ * @note the methods are `const`, so that the `const` methods of the heaps
+ *       can count as well - and the `static constexpr` counter can be used
+ *       the same way.
+ */
+class HeapStatisticsCounter {
+
+#ifdef HEAP_STATISTICS
+  protected:
+    mutable HeapStatistics _statistics;
+#endif
+
+  public:
+    /// @brief Adds @p amount to the given @p counter.
+    void count(unsigned long HeapStatistics::*counter,
+               unsigned long amount = 1) const {
+#ifdef HEAP_STATISTICS
+        _statistics.*counter += amount;
+#else
+        (void) counter;
+        (void) amount;
+#endif
+    }
+
+  public:
+    /// @brief Counts a single sift of an element, that moved @p depth levels.
+    void countSift(unsigned long depth) const {
+#ifdef HEAP_STATISTICS
+        _statistics.siftCount++;
+        _statistics.siftLevelCount += depth;
+        _statistics.maximumSiftDepth =
+                std::max(_statistics.maximumSiftDepth, depth);
+#else
+        (void) depth;
+#endif
+    }
+
+  public:
+    /// @return the counters so far - all `0` without `HEAP_STATISTICS`.
+    HeapStatistics get() const {
+#ifdef HEAP_STATISTICS
+        return _statistics;
+#else
+        return HeapStatistics();
+#endif
+    }
+
+  public:
+    /// @brief Sets all the counters back to `0`.
+    void reset() const {
+#ifdef HEAP_STATISTICS
+        _statistics = HeapStatistics();
+#endif
+    }
+};
+
+#endif // HEAP_STATISTICS_H
@@ -3,31 +3,33 @@
 #define INPUT_H
 
 #include "BaseArray.h"
+#include "LineReaderAdt.h"
 #include "Constants.h"
 #include "Unique.h"
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <string_view>
 #include <vector>
 
 /**
  * @brief This class bundles together all the input functions of the program.
  *
- * @version 1.0
+ * @version 1.1
  */
 class Input {
 
   private:
     /**
      * The minimum letter which is valid to be inputted.
-     * @see predicateIsValidLetter(std::string &)
+     * @see predicateIsValidLetter(std::string_view)
      */
     static constexpr char MINIMUM_LETTER = 'a';
 
   private:
     /**
      * The maximum letter which is valid to be inputted.
-     * @see predicateIsValidLetter(std::string &)
+     * @see predicateIsValidLetter(std::string_view)
      */
     static constexpr char MAXIMUM_LETTER = 'g';
 
@@ -56,9 +58,22 @@ class Input {
      * @see getTestArray(unsigned long &)
      */
     static unsigned long getValidNumberOfTestsDeclared() {
-        std::string numberOfTestsString;
-        numberOfTestsString = getLine(std::cin);
+        return getValidNumberOfTestsDeclared(getLine(std::cin));
+    }
+
+  public:
+    /**
+     * @brief Gets the number of tests for the user to input, from the given
+     *        @p reader.
+     * @see getValidNumberOfTestsDeclared()
+     */
+    static unsigned long getValidNumberOfTestsDeclared(LineReaderAdt &reader) {
+        return getValidNumberOfTestsDeclared(std::string(getLine(reader)));
+    }
 
+  private:
+    static unsigned long
+    getValidNumberOfTestsDeclared(std::string numberOfTestsString) {
         if (!predicateIsStringAnUnsignedNumber(numberOfTestsString)) {
             throw std::runtime_error(Constants::WRONG_INPUT);
         }
@@ -82,15 +97,20 @@ class Input {
      * @param i the index of the current test in the @p testArray given, you
      *          wish to extract.
      * @throws std::runtime_error in case the `testArray[i]` is not valid.
+     * @return the split test - as `std::string_view`s that view the
+     *         @p testLine given.
+     * @note the program decodes each line with `CommandDecoder` instead -
+     *       this method is kept as the *reference* that it must accept and
+     *       reject exactly the same as.
      * @see validateTest(std::string *&, char &, int)
      * @todo delete [] splitArray.
      */
-    static BaseArray<std::string> getTest(std::string &testLine, char delimiter,
-                                          unsigned long i) {
+    static BaseArray<std::string_view>
+    getTest(std::string_view testLine, char delimiter, unsigned long i) {
         try {
 
             // Split the `testLine` by ' ' delimiter.
-            BaseArray<std::string> splitArray = split(testLine, delimiter);
+            BaseArray<std::string_view> splitArray = split(testLine, delimiter);
 
             assertSplit(testLine, splitArray, i);
 
@@ -99,9 +119,9 @@ class Input {
     }
 
   private:
-    static void assertSplit(std::string &           testLine,
-                            BaseArray<std::string> &splitArray,
-                            unsigned long           i) {
+    static void assertSplit(std::string_view             testLine,
+                            BaseArray<std::string_view> &splitArray,
+                            unsigned long                i) {
 
         // Assert first letter.
         assertFirstLetter(testLine, splitArray, i);
@@ -111,9 +131,9 @@ class Input {
     }
 
   private:
-    static void assertFirstLetter(std::string &           testLine,
-                                  BaseArray<std::string> &splitArray,
-                                  unsigned long           i) {
+    static void assertFirstLetter(std::string_view             testLine,
+                                  BaseArray<std::string_view> &splitArray,
+                                  unsigned long                i) {
         if (i == 0) {
             if (testLine[0] != FIRST_LETTER) {
                 throw std::runtime_error(Constants::WRONG_INPUT);
@@ -130,10 +150,11 @@ class Input {
     }
 
   private:
-    static void assertAllowedTwoParameters(BaseArray<std::string> &splitArray) {
+    static void
+    assertAllowedTwoParameters(BaseArray<std::string_view> &splitArray) {
 
         // Allow only the letter `ALLOWED_TWO_PARAMETERS_LETTER`.
-        if (splitArray.getElement(0).c_str()[0] !=
+        if (splitArray.getElement(0)[0] !=
             ALLOWED_TWO_PARAMETERS_LETTER) {
             throw std::runtime_error(Constants::WRONG_INPUT);
         }
@@ -160,13 +181,44 @@ class Input {
      *        split strings of it to one.
      */
     static void mergeLastParameterWhenThereAreMoreThanThreeElements(
-            BaseArray<std::string> &splitArray) {
+            BaseArray<std::string_view> &splitArray) {
         if (splitArray.size() > 3) {
-            splitArray.mergeElements(2, 3, splitArray.size() - 1,
-                                     [&splitArray](auto &s1, auto &s2) {
-                                         return s1 + " " + s2;
-                                     });
+            mergeAdjacentViews(splitArray, 2, 3, splitArray.size() - 1);
+        }
+    }
+
+  private:
+    /**
+     * @brief *Merges* the views in the range `[first, last]` into the view
+     *        in the index of @p indexOfDestinationElement - as if they were
+     *        concatenated with a single delimiter between each two of them.
+     *        Then, removes the merged views from the @p splitArray.
+     *
+     * The views split out of a line by @link split @endlink are *adjacent*
+     * in the line - with exactly one delimiter between each two of them.
+     * So the merged view is a view of the line itself, and no `std::string`
+     * is built for it.
+     * @note the view in the @p indexOfDestinationElement must be set - and
+     *       the views after it must be @link split @endlink out of the same
+     *       line.
+     */
+    static void mergeAdjacentViews(
+            BaseArray<std::string_view> &splitArray,
+            unsigned long                indexOfDestinationElement,
+            unsigned long indexOfFirstElementToMergeToDestinationElement,
+            unsigned long indexOfLastElementToMergeToDestinationElement) {
+        std::string_view &destination =
+                splitArray.getElement(indexOfDestinationElement);
+
+        auto mergedLength = destination.length();
+        for (unsigned long i = indexOfFirstElementToMergeToDestinationElement;
+             i <= indexOfLastElementToMergeToDestinationElement; i++) {
+            mergedLength += 1 + splitArray.getElement(i).length();
         }
+        destination = std::string_view(destination.data(), mergedLength);
+
+        splitArray.shortenArray(indexOfFirstElementToMergeToDestinationElement,
+                                indexOfLastElementToMergeToDestinationElement);
     }
 
   private:
@@ -188,19 +240,19 @@ class Input {
      * @see MINIMUM_LETTER
      * @see MAXIMUM_LETTER
      */
-    static bool predicateIsValidLetter(std::string &str) {
+    static bool predicateIsValidLetter(std::string_view str) {
         return (str.length() == 1) && (MINIMUM_LETTER <= str[0]) &&
                (str[0] <= MAXIMUM_LETTER);
     }
 
   private:
     /**
-     * @param str the `std::string` to check if it represents an `unsigned`
+     * @param str the `std::string_view` to check if it represents an `unsigned`
      *            number.
      * @return `true` if the @p str given represents an `unsigned` number.
      *          Else, `false`.
      */
-    static bool predicateIsStringAnUnsignedNumber(std::string &str) {
+    static bool predicateIsStringAnUnsignedNumber(std::string_view str) {
         for (char c : str) {
             if (!(('0' <= c) && (c <= '9'))) { return false; }
         }
@@ -209,12 +261,13 @@ class Input {
 
   private:
     /**
-     * @param str the `std::string` to check if it represents an `int`
+     * @param str the `std::string_view` to check if it represents an `int`
      *            number.
      * @return `true` if the @p str given represents an `int` number.
      *          Else, `false`.
      */
-    static bool predicateIsStringAnInt(std::string &str) {
+    static bool predicateIsStringAnInt(std::string_view str) {
+        if (str.empty()) { return false; }
         if ((!(('0' <= str[0]) && (str[0] <= '9'))) &&
             (!((str[0] == '+') || str[0] == '-'))) {
             return false;
@@ -239,10 +292,29 @@ class Input {
         return getLineUntilEndingChar(istream, Constants::NEW_LINE);
     }
 
+  public:
+    /**
+     * @brief Gets a whole line from a @p reader - from the start of the
+     *        line until the `Constants::NEW_LINE` char (not included).
+     *
+     * @note The end of the input is treated as an *empty* line - which ends
+     *       the input.
+     * @param reader the reader to get a line from.
+     * @return a view of the line gotten, that is valid until the next line
+     *         is gotten from the @p reader.
+     * @see LineReaderAdt::getLine
+     */
+    static std::string_view getLine(LineReaderAdt &reader) {
+        std::string_view line;
+        reader.getLine(line, Constants::NEW_LINE);
+        return line;
+    }
+
   public:
     /**
      * @brief Gets a whole line from an input-stream - from the start of the
      *        line until the @p endingChar char (not included).
+     * @note The end of the input-stream ends the line as well.
      * @param istream the input-stream to get a line from.
      * @return a `std::string` that contains represents the line gotten from
      *         the given @p istream input-stream.
@@ -252,10 +324,8 @@ class Input {
         char        input;
         std::string returnValue = (char *) "";
 
-        istream.get(input);
-        while (input != endingChar) {
+        while (istream.get(input) && (input != endingChar)) {
             returnValue += input;
-            istream.get(input);
         }
         return returnValue;
     }
@@ -264,15 +334,17 @@ class Input {
     /**
      * @brief splits a given string by a given delimiter.
      *
-     * @param str the `std::string` to split by the given @p delimiter.
+     * @param str the `std::string_view` to split by the given @p delimiter.
      * @param delimiter a `std::string` that the given @p str will be
      *                  split by.
-     * @param outputSplitArray an _array of `std::string`s after split.
+     * @param outputSplitArray an _array of `std::string_view`s after split,
+     *                         that view the @p str.
      * @param outputSplitArraySize the size of the @p outputSplitArray.
      * @todo delete[] @p outputSplitArray.
      */
-    static BaseArray<std::string> split(std::string &str, char delimiter) {
-        BaseArray<std::string> splitArray(
+    static BaseArray<std::string_view> split(std::string_view str,
+                                             char             delimiter) {
+        BaseArray<std::string_view> splitArray(
                 countNumberOfDelimiterInString(str, delimiter) + 1);
         splitPrivate(str, delimiter, splitArray);
         return splitArray;
@@ -282,8 +354,8 @@ class Input {
     /**
      * @see split(std::string &, char, std::string *&, int &)
      */
-    static void splitPrivate(std::string &stringToSplit, char delimiter,
-                             BaseArray<std::string> &splitArray) {
+    static void splitPrivate(std::string_view stringToSplit, char delimiter,
+                             BaseArray<std::string_view> &splitArray) {
         long unsigned int stringToSplitIndex = 1;
         long unsigned int splitArrayIndex    = 0;
         long unsigned int startIndex         = 0;
@@ -310,8 +382,8 @@ class Input {
     }
 
   private:
-    static int countNumberOfDelimiterInString(std::string &str,
-                                              char         delimiter) {
+    static int countNumberOfDelimiterInString(std::string_view str,
+                                              char             delimiter) {
         int returnValue = 0;
         for (long unsigned int i = 1; i < str.length(); i++) {
             if ((str[i] == delimiter) && (str[i - 1] != delimiter)) {
@@ -0,0 +1,319 @@
+
+#ifndef IO_URING_H
+#define IO_URING_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+
+// Defined by <linux/fs.h>, and clashes with the constants of other classes.
+#undef BLOCK_SIZE
+
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define IO_URING_SUPPORTED
+#endif
+#endif
+
+/**
+ * @brief A minimal *io_uring* - the asynchronous I/O interface of Linux -
+ *        for submitting reads of a file, and waiting for their completion.
+ *
+ * The ring is set up with the raw `io_uring_setup` and `io_uring_enter`
+ * system-calls, without any library:
+ * @li Each read is written as an entry to the *submission* ring, which is
+ *     shared with the kernel - and all the entries written are then
+ *     submitted with a single @link submit @endlink.
+ * @li The kernel writes an entry to the *completion* ring for each read
+ *     that completed - in any order - with the `userData` of its read.
+ *
+ * A kernel (or a sandbox) that does not allow io_uring is not an error: in
+ * that case @link isAvailable @endlink returns `false`, and the reads should
+ * be made some other way - for example, with `pread`.
+ *
+ * For example:
+ * @code
+ * IoUring ring(4);
+ * if (ring.isAvailable()) {
+ *     iovec buffer {data, size};
+ *     ring.prepareRead(fd, &buffer, 0, 7);
+ *     ring.submit();
+ *     std::uint64_t userData;
+ *     int           result;
+ *     ring.waitForCompletion(userData, result); // userData == 7
+ * }
+ * @endcode
+ *
+ * @version 1.0
+ */
+class IoUring {
+
+  protected:
+    static constexpr char *ENTER_ERROR_MESSAGE =
+            (char *) "IoUring: failed to enter the ring.";
+
+  protected:
+    static constexpr char *FULL_ERROR_MESSAGE =
+            (char *) "IoUring: the submission ring is full.";
+
+  protected:
+    /// The file-descriptor of the ring. `-1` when it is not available.
+    int _fd = -1;
+
+#ifdef IO_URING_SUPPORTED
+  protected:
+    void *_submissionRing = nullptr;
+
+  protected:
+    unsigned long _submissionRingSize = 0;
+
+  protected:
+    /// `nullptr` when it is the same mapping as the `_submissionRing`.
+    void *_completionRing = nullptr;
+
+  protected:
+    unsigned long _completionRingSize = 0;
+
+  protected:
+    io_uring_sqe *_submissionEntries = nullptr;
+
+  protected:
+    unsigned long _submissionEntriesSize = 0;
+
+  protected:
+    unsigned *_submissionTail  = nullptr;
+    unsigned *_submissionHead  = nullptr;
+    unsigned *_submissionMask  = nullptr;
+    unsigned *_submissionArray = nullptr;
+
+  protected:
+    unsigned *    _completionHead    = nullptr;
+    unsigned *    _completionTail    = nullptr;
+    unsigned *    _completionMask    = nullptr;
+    io_uring_cqe *_completionEntries = nullptr;
+#endif
+
+  protected:
+    /// The amount of entries written, that were not submitted yet.
+    unsigned _pendingCount = 0;
+
+  public:
+    /**
+     * @param entryCount the maximum amount of reads that can be submitted
+     *                   at once.
+     */
+    explicit IoUring(unsigned entryCount) {
+#ifdef IO_URING_SUPPORTED
+        io_uring_params parameters {};
+        _fd = (int) ::syscall(__NR_io_uring_setup, entryCount, &parameters);
+        if (_fd < 0) {
+            _fd = -1;
+            return;
+        }
+        if (!mapRings(parameters)) {
+            unmapRings();
+            ::close(_fd);
+            _fd = -1;
+        }
+#else
+        (void) entryCount;
+#endif
+    }
+
+  public:
+    IoUring(const IoUring &other) = delete;
+
+  public:
+    IoUring &operator=(const IoUring &other) = delete;
+
+  public:
+    ~IoUring() {
+        if (_fd < 0) { return; }
+#ifdef IO_URING_SUPPORTED
+        unmapRings();
+#endif
+        ::close(_fd);
+    }
+
+  public:
+    /// @return `true` if the ring was set up. Else, `false`.
+    bool isAvailable() const { return _fd >= 0; }
+
+  public:
+    /**
+     * @brief Writes a read of the file in @p fd, at the given @p offset, into
+     *        the given @p buffer - to be submitted by the next
+     *        @link submit @endlink.
+     *
+     * @attention the @p buffer and the memory it points to **must** remain
+     *            valid until the read completes.
+     * @param userData identifies the read, in its completion.
+     * @throws std::runtime_error in case the submission ring is full.
+     */
+    void prepareRead(int fd, const iovec *buffer, std::uint64_t offset,
+                     std::uint64_t userData) {
+#ifdef IO_URING_SUPPORTED
+        unsigned tail = *_submissionTail;
+        unsigned head = __atomic_load_n(_submissionHead, __ATOMIC_ACQUIRE);
+        if (tail - head > *_submissionMask) {
+            throw std::runtime_error(FULL_ERROR_MESSAGE);
+        }
+
+        unsigned      index = tail & *_submissionMask;
+        io_uring_sqe *entry = &_submissionEntries[index];
+        std::memset(entry, 0, sizeof(*entry));
+        entry->opcode    = IORING_OP_READV;
+        entry->fd        = fd;
+        entry->addr      = (std::uint64_t) (std::uintptr_t) buffer;
+        entry->len       = 1;
+        entry->off       = offset;
+        entry->user_data = userData;
+
+        _submissionArray[index] = index;
+        __atomic_store_n(_submissionTail, tail + 1, __ATOMIC_RELEASE);
+        _pendingCount++;
+#else
+        (void) fd, (void) buffer, (void) offset, (void) userData;
+        throw std::runtime_error(FULL_ERROR_MESSAGE);
+#endif
+    }
+
+  public:
+    /**
+     * @brief Submits all the reads written since the last submit.
+     * @throws std::runtime_error in case the submission failed.
+     */
+    void submit() {
+        while (_pendingCount > 0) {
+            int submitted = enter(_pendingCount, 0, 0);
+            _pendingCount -= (unsigned) submitted;
+        }
+    }
+
+  public:
+    /**
+     * @brief Waits for a submitted read to complete.
+     *
+     * @param userData the `userData` of the read that completed.
+     * @param result the result of the read - the amount of bytes read, or a
+     *               negative `errno` value.
+     * @throws std::runtime_error in case the waiting failed.
+     */
+    void waitForCompletion(std::uint64_t &userData, int &result) {
+#ifdef IO_URING_SUPPORTED
+        while (true) {
+            unsigned head = *_completionHead;
+            unsigned tail =
+                    __atomic_load_n(_completionTail, __ATOMIC_ACQUIRE);
+            if (head != tail) {
+                io_uring_cqe &entry =
+                        _completionEntries[head & *_completionMask];
+                userData = entry.user_data;
+                result   = entry.res;
+                __atomic_store_n(_completionHead, head + 1, __ATOMIC_RELEASE);
+                return;
+            }
+            enter(0, 1, IORING_ENTER_GETEVENTS);
+        }
+#else
+        (void) userData, (void) result;
+        throw std::runtime_error(ENTER_ERROR_MESSAGE);
+#endif
+    }
+
+  protected:
+    /// @return the amount of entries submitted.
+    int enter(unsigned submitCount, unsigned waitCount, unsigned flags) {
+#ifdef IO_URING_SUPPORTED
+        while (true) {
+            long result = ::syscall(__NR_io_uring_enter, _fd, submitCount,
+                                    waitCount, flags, nullptr, 0);
+            if (result >= 0) { return (int) result; }
+            if ((errno != EINTR) && (errno != EAGAIN)) {
+                throw std::runtime_error(ENTER_ERROR_MESSAGE);
+            }
+        }
+#else
+        (void) submitCount, (void) waitCount, (void) flags;
+        throw std::runtime_error(ENTER_ERROR_MESSAGE);
+#endif
+    }
+
+#ifdef IO_URING_SUPPORTED
+  protected:
+    /// @return `true` if all of the rings were mapped. Else, `false`.
+    bool mapRings(const io_uring_params &parameters) {
+        _submissionRingSize = parameters.sq_off.array +
+                              parameters.sq_entries * sizeof(unsigned);
+        _completionRingSize = parameters.cq_off.cqes +
+                              parameters.cq_entries * sizeof(io_uring_cqe);
+        bool isSingleMapping = parameters.features & IORING_FEAT_SINGLE_MMAP;
+        if (isSingleMapping) {
+            _submissionRingSize =
+                    std::max(_submissionRingSize, _completionRingSize);
+        }
+
+        _submissionRing = mapRing(_submissionRingSize, IORING_OFF_SQ_RING);
+        if (_submissionRing == nullptr) { return false; }
+        void *completionRing = _submissionRing;
+        if (!isSingleMapping) {
+            _completionRing =
+                    mapRing(_completionRingSize, IORING_OFF_CQ_RING);
+            if (_completionRing == nullptr) { return false; }
+            completionRing = _completionRing;
+        }
+
+        _submissionEntriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+        _submissionEntries     = (io_uring_sqe *) mapRing(
+                _submissionEntriesSize, IORING_OFF_SQES);
+        if (_submissionEntries == nullptr) { return false; }
+
+        auto *submission  = (char *) _submissionRing;
+        _submissionTail   = (unsigned *) (submission + parameters.sq_off.tail);
+        _submissionHead   = (unsigned *) (submission + parameters.sq_off.head);
+        _submissionMask   =
+                (unsigned *) (submission + parameters.sq_off.ring_mask);
+        _submissionArray = (unsigned *) (submission + parameters.sq_off.array);
+
+        auto *completion   = (char *) completionRing;
+        _completionHead    = (unsigned *) (completion + parameters.cq_off.head);
+        _completionTail    = (unsigned *) (completion + parameters.cq_off.tail);
+        _completionMask    =
+                (unsigned *) (completion + parameters.cq_off.ring_mask);
+        _completionEntries =
+                (io_uring_cqe *) (completion + parameters.cq_off.cqes);
+        return true;
+    }
+
+  protected:
+    /// @return the ring mapped. `nullptr` in case it could not be mapped.
+    void *mapRing(unsigned long size, unsigned long long offset) {
+        void *ring = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, _fd, (off_t) offset);
+        return ring == MAP_FAILED ? nullptr : ring;
+    }
+
+  protected:
+    void unmapRings() {
+        if (_submissionEntries != nullptr) {
+            ::munmap(_submissionEntries, _submissionEntriesSize);
+        }
+        if (_completionRing != nullptr) {
+            ::munmap(_completionRing, _completionRingSize);
+        }
+        if (_submissionRing != nullptr) {
+            ::munmap(_submissionRing, _submissionRingSize);
+        }
+    }
+#endif
+};
+
+#endif // IO_URING_H
@@ -0,0 +1,165 @@
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * @brief A histogram of latencies - or of any other non-negative integer -
+ *        in *log-linear* buckets, the same way as an *HDR histogram*: each
+ *        power of 2 is split into `SUB_BUCKET_COUNT` linear buckets, so that
+ *        any value is recorded within a relative error of
+ *        `1 / SUB_BUCKET_COUNT`, in a fixed amount of memory, in `O(1)`.
+ *
+ * For example:
+ * @code
+ * LatencyHistogram histogram;
+ * histogram.record(latencyInNanoseconds);
+ * ...
+ * unsigned long p99 = histogram.getValueAtPercentile(99);
+ * @endcode
+ *
+ * @note the values below `SUB_BUCKET_COUNT` are recorded *exactly*.
+ * @version 1.0
+ */
+class LatencyHistogram {
+
+  public:
+    /// The amount of bits of the linear buckets in each power of 2.
+    static constexpr unsigned long SUB_BUCKET_BITS = 5;
+
+  public:
+    /// The amount of linear buckets in each power of 2.
+    static constexpr unsigned long SUB_BUCKET_COUNT = 1UL << SUB_BUCKET_BITS;
+
+  public:
+    /// The amount of buckets - enough for any `unsigned long` value.
+    static constexpr unsigned long BUCKET_COUNT =
+            (sizeof(unsigned long) * CHAR_BIT - SUB_BUCKET_BITS + 1) *
+            SUB_BUCKET_COUNT;
+
+  protected:
+    static constexpr char *PERCENTILE_MESSAGE =
+            (char *) "LatencyHistogram: the percentile must be in [0, 100].";
+
+  protected:
+    unsigned long _counts[BUCKET_COUNT] = {};
+
+  protected:
+    unsigned long _count = 0;
+
+  protected:
+    /// The sum of all the values - as a `double`, so that it never overflows.
+    double _sum = 0;
+
+  protected:
+    unsigned long _minimum = ULONG_MAX;
+
+  protected:
+    unsigned long _maximum = 0;
+
+  public:
+    /// @brief Records a single @p value.
+    void record(unsigned long value) { record(value, 1); }
+
+  public:
+    /// @brief Records the same @p value @p count times.
+    void record(unsigned long value, unsigned long count) {
+        _counts[getBucketIndex(value)] += count;
+        _count += count;
+        _sum += (double) value * (double) count;
+        _minimum = std::min(_minimum, value);
+        _maximum = std::max(_maximum, value);
+    }
+
+  public:
+    /// @brief Adds all the values recorded by the @p other histogram.
+    void add(const LatencyHistogram &other) {
+        for (unsigned long i = 0; i < BUCKET_COUNT; i++) {
+            _counts[i] += other._counts[i];
+        }
+        _count += other._count;
+        _sum += other._sum;
+        _minimum = std::min(_minimum, other._minimum);
+        _maximum = std::max(_maximum, other._maximum);
+    }
+
+  public:
+    /// @brief Forgets all the values recorded.
+    void clear() { *this = LatencyHistogram(); }
+
+  public:
+    unsigned long getCount() const { return _count; }
+
+  public:
+    /// @return the mean of the values recorded, or `0` if there are none.
+    double getMean() const { return (_count == 0) ? 0 : _sum / _count; }
+
+  public:
+    /// @return the minimum value recorded, or `0` if there are none.
+    unsigned long getMinimum() const { return (_count == 0) ? 0 : _minimum; }
+
+  public:
+    unsigned long getMaximum() const { return _maximum; }
+
+  public:
+    /**
+     * @return the value that @p percentile percents of the values recorded
+     *         are lower than or equal to - the *highest* value of its bucket,
+     *         but never more than the maximum value recorded. `0` if there
+     *         are no values.
+     * @param percentile between `0` and `100` - for example, `99.9`.
+     * @throws std::invalid_argument in case the @p percentile is not within
+     *         `[0, 100]`.
+     */
+    unsigned long getValueAtPercentile(double percentile) const {
+        if (!(percentile >= 0) || (percentile > 100)) {
+            throw std::invalid_argument(PERCENTILE_MESSAGE);
+        }
+        if (_count == 0) { return 0; }
+
+        auto rank = (unsigned long) std::ceil(percentile / 100 * _count);
+        rank      = std::max(1UL, rank);
+        unsigned long cumulative = 0;
+        for (unsigned long i = 0; i < BUCKET_COUNT; i++) {
+            cumulative += _counts[i];
+            if (cumulative >= rank) {
+                return std::max(_minimum,
+                                std::min(_maximum, getHighestValue(i)));
+            }
+        }
+        return _maximum;
+    }
+
+  protected:
+    /**
+     * @return the index of the bucket of the given @p value - the value
+     *         itself below `SUB_BUCKET_COUNT`. Else, the bucket of its power
+     *         of 2, and then its linear bucket by the `SUB_BUCKET_BITS` bits
+     *         after its most significant bit.
+     */
+    static unsigned long getBucketIndex(unsigned long value) {
+        if (value < SUB_BUCKET_COUNT) { return value; }
+        unsigned long mostSignificantBit =
+                sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl(value);
+        unsigned long shift = mostSignificantBit - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT +
+               ((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+  protected:
+    /// @return the highest value of the bucket of the given @p index.
+    static unsigned long getHighestValue(unsigned long index) {
+        if (index < SUB_BUCKET_COUNT) { return index; }
+        unsigned long shift = index / SUB_BUCKET_COUNT - 1;
+        unsigned long lowest =
+                (SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+        return lowest + ((1UL << shift) - 1);
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,41 @@
+
+#ifndef LINE_READER_ADT_H
+#define LINE_READER_ADT_H
+
+#include "Constants.h"
+#include <string_view>
+
+/**
+ * @brief An interface for a source of *lines* - such as the standard input,
+ *        or a file.
+ *
+ * Each line is returned as a `std::string_view`, that views the line
+ * *without* copying it.
+ * @attention a line returned is valid *only* until the next call to
+ *            @link getLine @endlink.
+ */
+class LineReaderAdt {
+
+  public:
+    LineReaderAdt() = default;
+
+  public:
+    virtual ~LineReaderAdt() = default;
+
+  public:
+    /**
+     * @brief Gets the next line - from the start of the line until the
+     *        @p endingChar char (not included).
+     *
+     * @note The last line does not have to end with the @p endingChar.
+     * @param line the line gotten. Set to an *empty* view when there are no
+     *             more lines.
+     * @param endingChar the char that ends each line.
+     * @return `true` if a line was gotten. `false` if the end of the input
+     *         was reached *before* a line was gotten.
+     */
+    virtual bool getLine(std::string_view &line,
+                         char endingChar = Constants::NEW_LINE) = 0;
+};
+
+#endif // LINE_READER_ADT_H
@@ -0,0 +1,180 @@
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "LineReaderAdt.h"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief This class *maps* a whole file to memory with `mmap`, and reads
+ *        lines out of it *in-place*.
+ *
+ * Each line returned is a `std::string_view` directly into the mapped
+ * memory - so no line is ever copied.
+ *
+ * A file that is *not* a regular file (for example, a pipe or a terminal)
+ * can not be mapped. In that case, @link isMapped @endlink returns `false`,
+ * and the file should be read via its @link getFd @endlink instead.
+ *
+ * For example:
+ * @code
+ * MappedFile file("commands.txt");
+ * std::string_view line;
+ * if (file.isMapped()) {
+ *     while (file.getLine(line)) { std::cout << line << std::endl; }
+ * }
+ * @endcode
+ *
+ * @note unlike other `LineReaderAdt`s, a line returned remains valid as
+ *       long as `this` object lives.
+ * @version 1.1
+ */
+class MappedFile : public LineReaderAdt {
+
+  protected:
+    static constexpr char *OPEN_ERROR_MESSAGE =
+            (char *) "MappedFile: failed to open the file.";
+
+  protected:
+    static constexpr char *MAP_ERROR_MESSAGE =
+            (char *) "MappedFile: failed to map the file.";
+
+  protected:
+    int _fd = -1;
+
+  protected:
+    /// The mapped memory. `nullptr` when the file is not mapped, or empty.
+    char *_data = nullptr;
+
+  protected:
+    unsigned long _size = 0;
+
+  protected:
+    bool _isMapped = false;
+
+  protected:
+    /// The offset of the next line in the `_data`.
+    unsigned long _position = 0;
+
+  public:
+    /**
+     * @param path the path of the file to map.
+     * @throws std::runtime_error in case the file could not be opened, or
+     *         in case it is a regular file that could not be mapped.
+     */
+    explicit MappedFile(const std::string &path) {
+        _fd = ::open(path.c_str(), O_RDONLY);
+        if (_fd < 0) { throw std::runtime_error(OPEN_ERROR_MESSAGE); }
+
+        struct stat fileStatus {};
+        if ((::fstat(_fd, &fileStatus) != 0) || !S_ISREG(fileStatus.st_mode)) {
+            return;
+        }
+
+        _size     = (unsigned long) fileStatus.st_size;
+        _isMapped = true;
+        if (_size == 0) { return; }
+
+        void *data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(_fd);
+            throw std::runtime_error(MAP_ERROR_MESSAGE);
+        }
+        _data = (char *) data;
+
+        // The file is read from its start to its end, only once.
+        ::madvise(_data, _size, MADV_SEQUENTIAL);
+    }
+
+  public:
+    MappedFile(const MappedFile &other) = delete;
+
+  public:
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+  public:
+    ~MappedFile() override {
+        if (_data != nullptr) { ::munmap(_data, _size); }
+        if (_fd >= 0) { ::close(_fd); }
+    }
+
+  public:
+    /// @return `true` if the file is a regular file, that is mapped.
+    bool isMapped() const { return _isMapped; }
+
+  public:
+    /// @return the file-descriptor of the file. Owned by `this` object.
+    int getFd() const { return _fd; }
+
+  public:
+    /// @return a view of the *whole* mapped file.
+    std::string_view getView() const {
+        return std::string_view(_data, _data == nullptr ? 0 : _size);
+    }
+
+  public:
+    bool getLine(std::string_view &line,
+                 char              endingChar = Constants::NEW_LINE) override {
+        if (_position >= _size) {
+            line = std::string_view();
+            return false;
+        }
+
+        const char *start = _data + _position;
+        auto *      found = (const char *) std::memchr(start, endingChar,
+                                                      _size - _position);
+        unsigned long lineLength =
+                (found == nullptr) ? _size - _position : found - start;
+
+        line = std::string_view(start, lineLength);
+        _position += lineLength + 1;
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Gets the next byte of the file, *without* consuming it.
+     * @return `true` if a byte was gotten. `false` on the end of the file.
+     */
+    bool peekByte(char &byte) const {
+        if (_position >= _size) { return false; }
+        byte = _data[_position];
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Gets the next byte of the file.
+     * @return `true` if a byte was gotten. `false` on the end of the file.
+     */
+    bool readByte(char &byte) {
+        if (_position >= _size) { return false; }
+        byte = _data[_position++];
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Gets the next @p size bytes of the file - *in-place*, the same
+     *        way as a line of @link getLine @endlink.
+     * @return `true` if all of the @p size bytes were gotten. `false` in case
+     *         the file ended before them.
+     */
+    bool readView(unsigned long size, std::string_view &view) {
+        if ((_position > _size) || (_size - _position < size)) {
+            return false;
+        }
+        view = std::string_view(_data + _position, size);
+        _position += size;
+        return true;
+    }
+};
+
+#endif // MAPPED_FILE_H
@@ -17,21 +17,28 @@
  * @li The heap compares its elements to each other, by the comparable `key`
  * field located in each `element`.
  * @tparam E the type of each `element`.
+ * @tparam Allocator a std-allocator compatible allocator, that the heap's
+ *                   array is allocated with.
  * @note The terms `element`, `node` are synonyms.
  * @attention The `elements` pointed must be **lvalues**.
  * @see Heap
  */
-template<typename E> class MaxHeap : public Heap<E> {
+template<typename E, typename Allocator = std::allocator<E>>
+class MaxHeap : public Heap<E, Allocator> {
 
   public:
-    MaxHeap(E *arrayToBuildFrom, unsigned long sizeOfArrayToBuildFrom)
-        : Heap<E>(arrayToBuildFrom, sizeOfArrayToBuildFrom) {}
+    MaxHeap(E *arrayToBuildFrom, unsigned long sizeOfArrayToBuildFrom,
+            const Allocator &allocator = Allocator())
+        : Heap<E, Allocator>(arrayToBuildFrom, sizeOfArrayToBuildFrom,
+                             allocator) {}
 
   public:
-    explicit MaxHeap(unsigned long physicalSize) : Heap<E>(physicalSize) {}
+    explicit MaxHeap(unsigned long   physicalSize,
+                     const Allocator &allocator = Allocator())
+        : Heap<E, Allocator>(physicalSize, allocator) {}
 
   public:
-    MaxHeap() : Heap<E>() {}
+    MaxHeap() : Heap<E, Allocator>() {}
 
   public:
     virtual ~MaxHeap() = default;
@@ -14,26 +14,38 @@
  *        the `Heap` and `MaxHeap` classes.
  *
  * @note `ElementInMinHeapAndMaxHeap<E>` will be also be referred as `EWrapper`.
+ * @tparam Allocator a std-allocator compatible allocator, that the heap's
+ *                   array is allocated with. Rebound to `EWrapper`.
  * @see MaxHeap
  * @see Heap
  */
-template<typename E>
+template<typename E, typename Allocator = std::allocator<E>>
 class MaxHeapWhenAlsoHavingMinHeap
-    : public MaxHeap<ElementInMinHeapAndMaxHeap<E>> {
+    : public MaxHeap<ElementInMinHeapAndMaxHeap<E>,
+                     BasicAllocations::Rebind<ElementInMinHeapAndMaxHeap<E>,
+                                              Allocator>> {
 
     typedef ElementInMinHeapAndMaxHeap<E> EWrapper;
 
+    typedef BasicAllocations::Rebind<EWrapper, Allocator> EWrapperAllocator;
+
   public:
     MaxHeapWhenAlsoHavingMinHeap() = default;
 
   public:
-    explicit MaxHeapWhenAlsoHavingMinHeap(unsigned long physicalSize)
-        : MaxHeap<EWrapper>(physicalSize) {}
+    explicit MaxHeapWhenAlsoHavingMinHeap(
+            unsigned long    physicalSize,
+            const Allocator &allocator = Allocator())
+        : MaxHeap<EWrapper, EWrapperAllocator>(physicalSize,
+                                               EWrapperAllocator(allocator)) {}
 
   public:
-    MaxHeapWhenAlsoHavingMinHeap(EWrapper *    arrayToBuildFrom,
-                                 unsigned long sizeOfArrayToBuildFrom)
-        : MaxHeap<EWrapper>(arrayToBuildFrom, sizeOfArrayToBuildFrom) {}
+    MaxHeapWhenAlsoHavingMinHeap(EWrapper *       arrayToBuildFrom,
+                                 unsigned long    sizeOfArrayToBuildFrom,
+                                 const Allocator &allocator = Allocator())
+        : MaxHeap<EWrapper, EWrapperAllocator>(arrayToBuildFrom,
+                                               sizeOfArrayToBuildFrom,
+                                               EWrapperAllocator(allocator)) {}
 
   protected:
     void onSwapIsNeeded(unsigned long index1,
@@ -44,16 +56,19 @@ class MaxHeapWhenAlsoHavingMinHeap
 
         // Update this element's heap-index to the new index:
         (this->_array[index2])->setMaxHeapIndex(index1);
+        this->_statisticsCounter.count(&HeapStatistics::indexWriteCount, 2);
 
         // Swap the elements:
-        Heap<EWrapper>::onSwapIsNeeded(index1, index2);
+        Heap<EWrapper, EWrapperAllocator>::onSwapIsNeeded(index1, index2);
     }
 
   protected:
     void onUpdateElementWithIndex(EWrapper *&   element,
                                   unsigned long newIndex) const override {
-        // Heap<EWrapper>::onUpdateElementWithIndex(element, newIndex);
+        // Heap<EWrapper, EWrapperAllocator>::onUpdateElementWithIndex(
+        //         element, newIndex);
         element->setMaxHeapIndex(newIndex);
+        this->_statisticsCounter.count(&HeapStatistics::indexWriteCount);
     }
 };
 
@@ -0,0 +1,143 @@
+
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief The bytes held by a part of a `PriorityQueueKv` - broken down by
+ *        what they hold - to size the hosts it runs on.
+ *
+ * For example:
+ * @code
+ * PriorityQueueKv<int, std::string> priorityQueueKv(1000000);
+ * ...
+ * std::cerr << priorityQueueKv.memoryUsage() << std::endl;
+ * @endcode
+ *
+ * @note the bytes are those *requested* from the allocator - the overhead
+ *       of the allocator itself (for example, the header of each `malloc`)
+ *       is not counted.
+ * @see PriorityQueueKvMemoryUsage
+ * @version 1.0
+ */
+struct MemoryUsage {
+
+    /// The arrays of the heaps - a pointer per slot, used or not.
+    unsigned long heapArrayBytes = 0;
+
+    /// The part of `heapArrayBytes` of the slots not used - the slack.
+    unsigned long heapArraySlackBytes = 0;
+
+    /// The `ElementInMinHeapAndMaxHeap` of each element.
+    unsigned long wrapperBytes = 0;
+
+    /// The `Unique` of each element.
+    unsigned long uniqueBytes = 0;
+
+    /// The `Entry` of each element, including the padding of its node.
+    unsigned long entryBytes = 0;
+
+    /**
+     * The memory that the keys and the values allocate by themselves - for
+     * example, a `std::string` longer than its small-string buffer.
+     */
+    unsigned long keyAndValueBytes = 0;
+
+    /**
+     * Everything else - the objects of the heaps and of the halves, and the
+     * nodes that a `NodePool` allocated and that are not in use.
+     */
+    unsigned long otherBytes = 0;
+
+    unsigned long getTotal() const {
+        return heapArrayBytes + wrapperBytes + uniqueBytes + entryBytes +
+               keyAndValueBytes + otherBytes;
+    }
+
+    /// @brief Adds all the bytes of the @p other usage to these.
+    MemoryUsage &operator+=(const MemoryUsage &other) {
+        heapArrayBytes += other.heapArrayBytes;
+        heapArraySlackBytes += other.heapArraySlackBytes;
+        wrapperBytes += other.wrapperBytes;
+        uniqueBytes += other.uniqueBytes;
+        entryBytes += other.entryBytes;
+        keyAndValueBytes += other.keyAndValueBytes;
+        otherBytes += other.otherBytes;
+        return *this;
+    }
+
+    /// @brief Prints each part as `name: bytes`, one per line.
+    friend std::ostream &operator<<(std::ostream &     os,
+                                    const MemoryUsage &memoryUsage) {
+        os << "heap arrays: " << memoryUsage.heapArrayBytes << "\n"
+           << "heap arrays slack: " << memoryUsage.heapArraySlackBytes << "\n"
+           << "wrappers: " << memoryUsage.wrapperBytes << "\n"
+           << "uniques: " << memoryUsage.uniqueBytes << "\n"
+           << "entries: " << memoryUsage.entryBytes << "\n"
+           << "keys and values: " << memoryUsage.keyAndValueBytes << "\n"
+           << "other: " << memoryUsage.otherBytes << "\n"
+           << "total: " << memoryUsage.getTotal();
+        return os;
+    }
+
+    /**
+     * @return the bytes that the given @p value allocates by itself, beyond
+     *         its own `sizeof` - the capacity of a `std::string` that is not
+     *         within its small-string buffer, and `0` for anything else.
+     */
+    template<typename T>
+    static unsigned long getAllocatedBytes(const T &value) {
+        if constexpr (std::is_same<T, std::string>::value) {
+            const char *data = value.data();
+            const auto *self = (const char *) &value;
+            bool isWithinItself = (self <= data) && (data < self + sizeof(T));
+            return isWithinItself ? 0 : (unsigned long) value.capacity() + 1;
+        } else {
+            (void) value;
+            return 0;
+        }
+    }
+};
+
+/**
+ * @brief The `MemoryUsage` of a `PriorityQueueKv` - of each of its two
+ *        halves, and of what the halves share.
+ * @see PriorityQueueKv::memoryUsage
+ */
+struct PriorityQueueKvMemoryUsage {
+
+    /// The half of the elements that are less than or equal to the median.
+    MemoryUsage lessOrEqualToMedian;
+
+    /// The half of the elements that are greater than the median.
+    MemoryUsage greaterThanMedian;
+
+    /// The `PriorityQueueKv` itself, and the nodes of its pool not in use.
+    MemoryUsage shared;
+
+    /// @return the usage of all the parts together.
+    MemoryUsage getTotal() const {
+        MemoryUsage total = lessOrEqualToMedian;
+        total += greaterThanMedian;
+        total += shared;
+        return total;
+    }
+
+    /// @brief Prints the total bytes of each part, then the breakdown of all.
+    friend std::ostream &
+    operator<<(std::ostream &                    os,
+               const PriorityQueueKvMemoryUsage &memoryUsage) {
+        os << "less or equal to median: "
+           << memoryUsage.lessOrEqualToMedian.getTotal() << "\n"
+           << "greater than median: "
+           << memoryUsage.greaterThanMedian.getTotal() << "\n"
+           << "shared: " << memoryUsage.shared.getTotal() << "\n"
+           << memoryUsage.getTotal();
+        return os;
+    }
+};
+
+#endif // MEMORY_USAGE_H
@@ -17,21 +17,28 @@
  * @li The heap compares its elements to each other, by the comparable `key`
  * field located in each `element`.
  * @tparam E the type of each `element`.
+ * @tparam Allocator a std-allocator compatible allocator, that the heap's
+ *                   array is allocated with.
  * @note The terms `element`, `node` are synonyms.
  * @attention The `elements` pointed must be **lvalues**.
  * @see Heap
  */
-template<typename E> class MinHeap : public Heap<E> {
+template<typename E, typename Allocator = std::allocator<E>>
+class MinHeap : public Heap<E, Allocator> {
 
   public:
-    MinHeap(E *arrayToBuildFrom, unsigned long sizeOfArrayToBuildFrom)
-        : Heap<E>(arrayToBuildFrom, sizeOfArrayToBuildFrom) {}
+    MinHeap(E *arrayToBuildFrom, unsigned long sizeOfArrayToBuildFrom,
+            const Allocator &allocator = Allocator())
+        : Heap<E, Allocator>(arrayToBuildFrom, sizeOfArrayToBuildFrom,
+                             allocator) {}
 
   public:
-    explicit MinHeap(unsigned long physicalSize) : Heap<E>(physicalSize) {}
+    explicit MinHeap(unsigned long   physicalSize,
+                     const Allocator &allocator = Allocator())
+        : Heap<E, Allocator>(physicalSize, allocator) {}
 
   public:
-    MinHeap() : Heap<E>() {}
+    MinHeap() : Heap<E, Allocator>() {}
 
   public:
     virtual ~MinHeap() = default;
@@ -14,26 +14,38 @@
  *        the `Heap` and `MinHeap` classes.
  *
  * @note `ElementInMinHeapAndMaxHeap<E>` will be also be referred as `EWrapper`.
+ * @tparam Allocator a std-allocator compatible allocator, that the heap's
+ *                   array is allocated with. Rebound to `EWrapper`.
  * @see MinHeap
  * @see Heap
  */
-template<typename E>
+template<typename E, typename Allocator = std::allocator<E>>
 class MinHeapWhenAlsoHavingMaxHeap
-    : public MinHeap<ElementInMinHeapAndMaxHeap<E>> {
+    : public MinHeap<ElementInMinHeapAndMaxHeap<E>,
+                     BasicAllocations::Rebind<ElementInMinHeapAndMaxHeap<E>,
+                                              Allocator>> {
 
     typedef ElementInMinHeapAndMaxHeap<E> EWrapper;
 
+    typedef BasicAllocations::Rebind<EWrapper, Allocator> EWrapperAllocator;
+
   public:
     MinHeapWhenAlsoHavingMaxHeap() = default;
 
   public:
-    explicit MinHeapWhenAlsoHavingMaxHeap(unsigned long physicalSize)
-        : MinHeap<EWrapper>(physicalSize) {}
+    explicit MinHeapWhenAlsoHavingMaxHeap(
+            unsigned long    physicalSize,
+            const Allocator &allocator = Allocator())
+        : MinHeap<EWrapper, EWrapperAllocator>(physicalSize,
+                                               EWrapperAllocator(allocator)) {}
 
   public:
-    MinHeapWhenAlsoHavingMaxHeap(EWrapper *    arrayToBuildFrom,
-                                 unsigned long sizeOfArrayToBuildFrom)
-        : MinHeap<EWrapper>(arrayToBuildFrom, sizeOfArrayToBuildFrom) {}
+    MinHeapWhenAlsoHavingMaxHeap(EWrapper *       arrayToBuildFrom,
+                                 unsigned long    sizeOfArrayToBuildFrom,
+                                 const Allocator &allocator = Allocator())
+        : MinHeap<EWrapper, EWrapperAllocator>(arrayToBuildFrom,
+                                               sizeOfArrayToBuildFrom,
+                                               EWrapperAllocator(allocator)) {}
 
   protected:
     void onSwapIsNeeded(unsigned long index1,
@@ -44,16 +56,19 @@ class MinHeapWhenAlsoHavingMaxHeap
 
         // Update this element's heap-index to the new index:
         (this->_array[index2])->setMinHeapIndex(index1);
+        this->_statisticsCounter.count(&HeapStatistics::indexWriteCount, 2);
 
         // Swap the elements:
-        Heap<EWrapper>::onSwapIsNeeded(index1, index2);
+        Heap<EWrapper, EWrapperAllocator>::onSwapIsNeeded(index1, index2);
     }
 
   protected:
     void onUpdateElementWithIndex(EWrapper *&   element,
                                   unsigned long newIndex) const override {
-        // Heap<EWrapper>::onUpdateElementWithIndex(element, newIndex);
+        // Heap<EWrapper, EWrapperAllocator>::onUpdateElementWithIndex(
+        //         element, newIndex);
         element->setMinHeapIndex(newIndex);
+        this->_statisticsCounter.count(&HeapStatistics::indexWriteCount);
     }
 };
 
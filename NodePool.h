@@ -0,0 +1,271 @@
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include "BasicAllocations.h"
+#include "HeapStatistics.h"
+#include "Tracepoints.h"
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief This class hands out storage for *nodes* of type `T`, carved out of
+ *        large *blocks* that are allocated with the given `Allocator`.
+ *
+ * @li A node that is `destroy`ed returns to a *free-list*, and is reused by
+ * the next node `create`d.
+ * @li The @link release @endlink method *rewinds* the pool in a *single*
+ * step - all the nodes are released at once, while all the blocks are kept
+ * for the next nodes to be `create`d. This is done in `O(1)`, regardless of
+ * the number of nodes that were `create`d beforehand.
+ * @li The blocks are returned to the `Allocator` only on destruction.
+ *
+ * For example:
+ * @code
+ * NodePool<std::string> pool;
+ * std::string *str = pool.create("hello");
+ * pool.destroy(str);       // `str`'s storage is reused by the next `create`.
+ *
+ * pool.create("world");
+ * pool.create("again");
+ * pool.release();          // Both nodes are released at once.
+ * @endcode
+ *
+ * @attention @link release @endlink does *not* destruct the nodes - it is
+ *            the responsibility of the user to destruct them beforehand,
+ *            unless `T` is *trivially destructible*.
+ * @tparam T the type of each node.
+ * @tparam Allocator a std-allocator compatible allocator, that the blocks are
+ *                   allocated with.
+ * @version 1.3
+ */
+template<typename T, typename Allocator = std::allocator<T>> class NodePool {
+
+  protected:
+    /// The capacity of the first block allocated, in nodes.
+    static constexpr unsigned long FIRST_BLOCK_CAPACITY = 64;
+
+  protected:
+    /// The capacity of each block is doubled, up to this capacity, in nodes.
+    static constexpr unsigned long MAXIMUM_BLOCK_CAPACITY = 1UL << 16;
+
+  protected:
+    /**
+     * The storage of a single node. While the node is *free*, its storage
+     * is reused to link it to the next free node.
+     */
+    union Slot {
+        Slot *nextFreeSlot;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+  protected:
+    /// A block of `capacity` contiguous `Slot`s.
+    struct Block {
+        Slot *        slots;
+        unsigned long capacity;
+        Block *       nextBlock;
+    };
+
+  protected:
+    Allocator _allocator;
+
+  protected:
+    /// The first block allocated. Initialized to `nullptr`.
+    Block *_firstBlock = nullptr;
+
+  protected:
+    /// The block that new nodes are carved out of. Initialized to `nullptr`.
+    Block *_currentBlock = nullptr;
+
+  protected:
+    /// The amount of `Slot`s already carved out of the `_currentBlock`.
+    unsigned long _usedSlotsInCurrentBlock = 0;
+
+  protected:
+    /// The head of the free-list. Initialized to `nullptr`.
+    Slot *_freeSlots = nullptr;
+
+  protected:
+    /// The sum of the capacities of all the blocks allocated, in nodes.
+    unsigned long _capacity = 0;
+
+  protected:
+    /**
+     * Counts the nodes `create`d and the blocks allocated - only when built
+     * with `HEAP_STATISTICS`.
+     */
+#ifdef HEAP_STATISTICS
+    HeapStatisticsCounter _statisticsCounter;
+#else
+    static constexpr HeapStatisticsCounter _statisticsCounter {};
+#endif
+
+  public:
+    explicit NodePool(const Allocator &allocator = Allocator())
+        : _allocator(allocator) {}
+
+  public:
+    NodePool(const NodePool &other) = delete;
+
+  public:
+    NodePool &operator=(const NodePool &other) = delete;
+
+  public:
+    virtual ~NodePool() { deleteThis(); }
+
+  protected:
+    void deleteThis() {
+        Block *block = _firstBlock;
+        while (block != nullptr) {
+            Block *nextBlock = block->nextBlock;
+            BasicAllocations::deallocateArray(_allocator, block->slots,
+                                              block->capacity);
+            BasicAllocations::deallocateArray(_allocator, block, 1);
+            block = nextBlock;
+        }
+        _firstBlock   = nullptr;
+        _currentBlock = nullptr;
+    }
+
+  public:
+    /// @return the sum of the capacities of all the blocks, in nodes.
+    unsigned long getCapacity() const { return _capacity; }
+
+  public:
+    /// @return the bytes of all the blocks allocated - used or not.
+    unsigned long getAllocatedBytes() const {
+        unsigned long bytes = 0;
+        for (Block *block = _firstBlock; block != nullptr;
+             block        = block->nextBlock) {
+            bytes += sizeof(Block) + block->capacity * sizeof(Slot);
+        }
+        return bytes;
+    }
+
+  public:
+    /**
+     * @return the amount of nodes `create`d and of blocks allocated so far -
+     *         both `0` unless built with `HEAP_STATISTICS`.
+     */
+    HeapStatistics getStatistics() const { return _statisticsCounter.get(); }
+
+  public:
+    /**
+     * @brief Allocates a node from the pool, and constructs it with the
+     *        given @p args.
+     *
+     * @param args the arguments to construct the node with.
+     * @return the node created.
+     */
+    template<typename... Args> T *create(Args &&...args) {
+        Slot *slot = allocateSlot();
+        _statisticsCounter.count(&HeapStatistics::nodeAllocationCount);
+        try {
+            return ::new ((void *) slot) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocateSlot(slot);
+            throw;
+        }
+    }
+
+  public:
+    /**
+     * @brief Destructs the given @p node, and returns its storage to the
+     *        pool.
+     *
+     * @note `nullptr` resistant - does nothing for a `nullptr` @p node.
+     * @param node a node that was `create`d by `this` pool.
+     */
+    void destroy(T *node) {
+        if (node == nullptr) { return; }
+        node->~T();
+        deallocateSlot(reinterpret_cast<Slot *>(node));
+    }
+
+  public:
+    /**
+     * @brief Releases *all* the nodes at once, in `O(1)`, while keeping all
+     *        the blocks for reuse.
+     *
+     * @attention the nodes are *not* destructed.
+     */
+    void release() {
+        _currentBlock            = _firstBlock;
+        _usedSlotsInCurrentBlock = 0;
+        _freeSlots               = nullptr;
+    }
+
+  protected:
+    Slot *allocateSlot() {
+        if (_freeSlots != nullptr) {
+            Slot *slot = _freeSlots;
+            _freeSlots = slot->nextFreeSlot;
+            return slot;
+        }
+
+        if ((_currentBlock == nullptr) ||
+            (_usedSlotsInCurrentBlock == _currentBlock->capacity)) {
+            advanceToNextBlock();
+        }
+        return &_currentBlock->slots[_usedSlotsInCurrentBlock++];
+    }
+
+  protected:
+    void deallocateSlot(Slot *slot) {
+        slot->nextFreeSlot = _freeSlots;
+        _freeSlots         = slot;
+    }
+
+  protected:
+    /**
+     * @brief Moves the `_currentBlock` to the next block - which is either a
+     *        block kept from before the last @link release @endlink, or a
+     *        `new` block that is twice the size of the last one.
+     */
+    void advanceToNextBlock() {
+        bool isThereAKeptBlock = (_currentBlock != nullptr) &&
+                                 (_currentBlock->nextBlock != nullptr);
+        if (isThereAKeptBlock) {
+            _currentBlock            = _currentBlock->nextBlock;
+            _usedSlotsInCurrentBlock = 0;
+            return;
+        }
+
+        unsigned long capacity = FIRST_BLOCK_CAPACITY;
+        if (_currentBlock != nullptr) {
+            capacity = _currentBlock->capacity * 2;
+            if (capacity > MAXIMUM_BLOCK_CAPACITY) {
+                capacity = MAXIMUM_BLOCK_CAPACITY;
+            }
+        }
+
+        // The block is not linked yet - so it is freed here, if its slots
+        // could not be allocated.
+        auto *block = BasicAllocations::allocateArray<Block>(_allocator, 1);
+        try {
+            block->slots =
+                    BasicAllocations::allocateArray<Slot>(_allocator, capacity);
+        } catch (...) {
+            BasicAllocations::deallocateArray(_allocator, block, 1);
+            throw;
+        }
+        block->capacity  = capacity;
+        block->nextBlock = nullptr;
+        _capacity += capacity;
+        _statisticsCounter.count(&HeapStatistics::blockAllocationCount);
+        PRIORITY_QUEUE_KV_TRACE(node_pool_grow, capacity, _capacity);
+
+        if (_currentBlock == nullptr) {
+            _firstBlock = block;
+        } else {
+            _currentBlock->nextBlock = block;
+        }
+        _currentBlock            = block;
+        _usedSlotsInCurrentBlock = 0;
+    }
+};
+
+#endif // NODE_POOL_H
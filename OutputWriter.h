@@ -0,0 +1,306 @@
+
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include "Constants.h"
+#include "Entry.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unistd.h>
+
+/**
+ * @brief This class writes the *results* of the program to a
+ *        file-descriptor, through its own *buffer*.
+ *
+ * Instead of flushing the output after each result (as `std::endl` does),
+ * the results are gathered in the buffer, and written with the `write()`
+ * system-call only by the @link FlushPolicy @endlink - without going
+ * through `std::ostream` or the C `stdio`:
+ * @li Integers are formatted directly into the buffer, two digits at a time.
+ * @li Strings are copied into the buffer as they are.
+ *
+ * For example:
+ * @code
+ * OutputWriter writer(STDOUT_FILENO);
+ * writer.write(Entry<int, std::string>(3, "hi"));
+ * writer.endLine();
+ * writer.flush();
+ * // prints "3 hi\n"
+ * @endcode
+ *
+ * @note What was not flushed yet is flushed by the destructor - so when an
+ *       exception unwinds the stack, the results before it are still
+ *       written, *before* anything printed by the handler of the exception.
+ * @version 1.0
+ */
+class OutputWriter {
+
+  public:
+    /// When the buffer is written to the file-descriptor.
+    enum class FlushPolicy {
+
+        /// When the buffer is full.
+        SIZE,
+
+        /// At the end of each line - for an *interactive* output.
+        LINE,
+
+        /// Only on @link flush @endlink - the buffer grows as needed.
+        EXPLICIT,
+    };
+
+  public:
+    /// The default size of the buffer, in bytes.
+    static constexpr unsigned long DEFAULT_BUFFER_SIZE = 1UL << 16;
+
+  protected:
+    static constexpr char *WRITE_ERROR_MESSAGE =
+            (char *) "OutputWriter: failed to write to the output.";
+
+  protected:
+    static constexpr char *BUFFER_SIZE_MESSAGE =
+            (char *) "OutputWriter: `bufferSize` must be at least `1`.";
+
+  protected:
+    /// The maximum amount of chars of a formatted integer.
+    static constexpr unsigned long MAXIMUM_INTEGER_LENGTH = 20;
+
+  protected:
+    /// The file-descriptor to write to.
+    int _fd = -1;
+
+  protected:
+    FlushPolicy _flushPolicy = FlushPolicy::SIZE;
+
+  protected:
+    /// The buffer that the output is gathered in.
+    std::unique_ptr<char[]> _buffer;
+
+  protected:
+    unsigned long _capacity = 0;
+
+  protected:
+    /// The amount of chars in the `_buffer`, that were not written yet.
+    unsigned long _size = 0;
+
+  public:
+    /**
+     * @param fd the file-descriptor to write to. It is *not* closed by
+     *           `this` writer.
+     * @param flushPolicy when to write the buffer to the @p fd.
+     * @param bufferSize the size of the buffer, in bytes. With
+     *                   `FlushPolicy::EXPLICIT` - its *initial* size.
+     */
+    explicit OutputWriter(int           fd,
+                          FlushPolicy   flushPolicy = FlushPolicy::SIZE,
+                          unsigned long bufferSize  = DEFAULT_BUFFER_SIZE)
+        : _fd(fd), _flushPolicy(flushPolicy) {
+        if (bufferSize < 1) {
+            throw std::invalid_argument(BUFFER_SIZE_MESSAGE);
+        }
+        _buffer   = std::unique_ptr<char[]>(new char[bufferSize]);
+        _capacity = bufferSize;
+    }
+
+  public:
+    OutputWriter(const OutputWriter &other) = delete;
+
+  public:
+    OutputWriter &operator=(const OutputWriter &other) = delete;
+
+  public:
+    /**
+     * @brief Flushes what was not flushed yet.
+     *
+     * @note a failure to write is *ignored* here - call
+     *       @link flush @endlink explicitly to detect it.
+     */
+    ~OutputWriter() {
+        try {
+            flush();
+        } catch (std::exception &e) {}
+    }
+
+  public:
+    /**
+     * @return `FlushPolicy::LINE` if the @p fd is a *terminal*. Else,
+     *         `FlushPolicy::SIZE`.
+     */
+    static FlushPolicy getDefaultFlushPolicy(int fd) {
+        return ::isatty(fd) ? FlushPolicy::LINE : FlushPolicy::SIZE;
+    }
+
+  public:
+    FlushPolicy getFlushPolicy() const { return _flushPolicy; }
+
+  public:
+    /// @return the amount of chars that were written, but not flushed yet.
+    unsigned long getBufferedSize() const { return _size; }
+
+  public:
+    /**
+     * @brief Writes all of the buffer to the file-descriptor.
+     * @throws std::runtime_error in case writing to the output failed.
+     */
+    void flush() {
+        unsigned long size = _size;
+        _size              = 0;
+        writeToFd(_buffer.get(), size);
+    }
+
+  public:
+    void write(char c) {
+        if (_size == _capacity) { makeRoomFor(1); }
+        _buffer[_size++] = c;
+    }
+
+  public:
+    void write(std::string_view str) {
+        if (_size + str.length() > _capacity) {
+            makeRoomFor(str.length());
+            if (str.length() > _capacity) {
+
+                // Too long to be buffered at all.
+                writeToFd(str.data(), str.length());
+                return;
+            }
+        }
+        std::memcpy(_buffer.get() + _size, str.data(), str.length());
+        _size += str.length();
+    }
+
+  public:
+    /// @brief Writes the given integer in decimal.
+    template<typename Integer,
+             typename = std::enable_if_t<std::is_integral_v<Integer>>>
+    void write(Integer integer) {
+        if (_capacity < MAXIMUM_INTEGER_LENGTH) {
+
+            // The buffer may never have room for it - write it as a string.
+            char digits[MAXIMUM_INTEGER_LENGTH];
+            write(std::string_view(digits, formatInteger(integer, digits)));
+            return;
+        }
+        if (_size + MAXIMUM_INTEGER_LENGTH > _capacity) {
+            makeRoomFor(MAXIMUM_INTEGER_LENGTH);
+        }
+        _size += formatInteger(integer, _buffer.get() + _size);
+    }
+
+  public:
+    /**
+     * @brief Writes the given @p entry the same way as its `operator<<` -
+     *        its *key*, a ' ' char, and its *value*.
+     */
+    template<typename K, typename V> void write(const Entry<K, V> &entry) {
+        write(entry.getKeyReference());
+        write(' ');
+        write(entry.getValueReference());
+    }
+
+  public:
+    /**
+     * @brief Writes a `Constants::NEW_LINE` char - and flushes, in case of
+     *        `FlushPolicy::LINE`.
+     */
+    void endLine() {
+        write(Constants::NEW_LINE);
+        if (_flushPolicy == FlushPolicy::LINE) { flush(); }
+    }
+
+  public:
+    /**
+     * @brief Formats the given integer in decimal, into the given @p output.
+     *
+     * @param output **must** be able to hold at least
+     *               `MAXIMUM_INTEGER_LENGTH` chars.
+     * @return the amount of chars formatted.
+     */
+    template<typename Integer>
+    static unsigned long formatInteger(Integer integer, char *output) {
+        typedef std::make_unsigned_t<Integer> Unsigned;
+
+        // The magnitude of the minimal value does not fit in `Integer`.
+        Unsigned magnitude  = (Unsigned) integer;
+        bool     isNegative = false;
+        if constexpr (std::is_signed_v<Integer>) {
+            if (integer < 0) {
+                magnitude  = (Unsigned) 0 - magnitude;
+                isNegative = true;
+            }
+        }
+
+        // Formatted backwards - from the last digit.
+        char  digits[MAXIMUM_INTEGER_LENGTH];
+        char *end   = digits + MAXIMUM_INTEGER_LENGTH;
+        char *begin = end;
+        while (magnitude >= 100) {
+            unsigned long pair = (unsigned long) (magnitude % 100) * 2;
+            magnitude /= 100;
+            *--begin = DIGIT_PAIRS[pair + 1];
+            *--begin = DIGIT_PAIRS[pair];
+        }
+        if (magnitude >= 10) {
+            unsigned long pair = (unsigned long) magnitude * 2;
+            *--begin           = DIGIT_PAIRS[pair + 1];
+            *--begin           = DIGIT_PAIRS[pair];
+        } else {
+            *--begin = (char) ('0' + magnitude);
+        }
+        if (isNegative) { *--begin = '-'; }
+
+        std::memcpy(output, begin, end - begin);
+        return end - begin;
+    }
+
+  protected:
+    /// All the pairs of digits, from "00" to "99".
+    static constexpr char DIGIT_PAIRS[] =
+            "000102030405060708091011121314151617181920212223242526272829"
+            "303132333435363738394041424344454647484950515253545556575859"
+            "606162636465666768697071727374757677787980818283848586878889"
+            "90919293949596979899";
+
+  protected:
+    /**
+     * @brief Makes room in the buffer for @p length more chars - by
+     *        flushing it, or by growing it in case of
+     *        `FlushPolicy::EXPLICIT`.
+     *
+     * @note the buffer may still be too small for the @p length chars,
+     *       unless it is grown.
+     */
+    void makeRoomFor(unsigned long length) {
+        if (_flushPolicy != FlushPolicy::EXPLICIT) {
+            flush();
+            return;
+        }
+
+        unsigned long capacity = std::max(_capacity * 2, _size + length);
+        std::unique_ptr<char[]> buffer(new char[capacity]);
+        std::memcpy(buffer.get(), _buffer.get(), _size);
+        _buffer   = (std::unique_ptr<char[]> &&) buffer;
+        _capacity = capacity;
+    }
+
+  protected:
+    /// @throws std::runtime_error in case writing to the output failed.
+    void writeToFd(const char *data, unsigned long size) {
+        while (size > 0) {
+            long bytesWritten = (long) ::write(_fd, data, size);
+            if (bytesWritten < 0) {
+                if (errno == EINTR) { continue; }
+                throw std::runtime_error(WRITE_ERROR_MESSAGE);
+            }
+            data += bytesWritten;
+            size -= bytesWritten;
+        }
+    }
+};
+
+#endif // OUTPUT_WRITER_H
@@ -0,0 +1,198 @@
+
+#ifndef PARALLEL_COMMAND_PARSER_H
+#define PARALLEL_COMMAND_PARSER_H
+
+#include "BasicAlgorithms.h"
+#include "CommandDecoder.h"
+#include "Constants.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief This class parses the lines of the "tests" of a *whole* input that
+ *        is already in memory (for example, a `MappedFile`) - on multiple
+ *        threads at once.
+ *
+ * The input is parsed in *waves*. Each wave is split to *chunks* that start
+ * and end on line boundaries, and each chunk is decoded by its own thread to
+ * its own array of `CommandDecoder::Command`s. The commands of the chunks are
+ * then *replayed* by their order, on the calling thread - so that the
+ * "tests" are run exactly as if they were parsed one by one:
+ * @li Only the first line of the input is decoded as the first "test" -
+ *     which must be exactly `e`. A chunk that starts *after* it decodes all
+ *     of its lines as later "tests".
+ * @li A chunk stops at its first *empty* line, or its first wrong line. The
+ *     commands before it are still replayed - and then the input ends, or
+ *     the wrong input is thrown. The chunks after it are ignored.
+ * @li The amount of "tests" replayed is checked against the amount declared,
+ *     before each "test" and at the end - exactly as `TestRunner` does.
+ *
+ * For example:
+ * @code
+ * ParallelCommandParser::parseAllTests(
+ *         data, numberOfTestsDeclared, [&](CommandDecoder::Command &test) {
+ *             run(test);
+ *             return true;
+ *         });
+ * @endcode
+ *
+ * @note the `value` of each command *views* the input - so the input must
+ *       remain valid while the commands are replayed.
+ * @see TestRunner::parseAllTests
+ * @version 1.0
+ */
+class ParallelCommandParser {
+
+  public:
+    /// The size of the input that is parsed by each thread in each wave.
+    static constexpr unsigned long CHUNK_SIZE = 1UL << 22;
+
+  protected:
+    /// The commands decoded out of a single chunk.
+    struct Chunk {
+
+        std::vector<CommandDecoder::Command> commands;
+
+        /// Whether the chunk stopped at an *empty* line.
+        bool isEndOfInput = false;
+
+        /// Whether the chunk stopped at a *wrong* line.
+        bool isWrongInput = false;
+    };
+
+  public:
+    /**
+     * @brief Parses the "tests" in the given @p data in parallel, and
+     *        invokes the given @p runTest function on each of them - by their
+     *        order.
+     *
+     * @param data the input *after* the line of the number of "tests"
+     *             declared.
+     * @param numberOfTestsDeclared the amount of "tests" declared.
+     * @param runTest a function that runs each "test" parsed. Returns `false`
+     *                in case the "tests" after it should not be parsed.
+     * @param threadCount the maximum amount of threads to use. `0` means the
+     *                    amount of hardware threads available.
+     * @throws std::runtime_error in case of a wrong input - after the
+     *         @p runTest was invoked on all the "tests" before it.
+     */
+    template<typename RunTest>
+    static void parseAllTests(std::string_view data,
+                              unsigned long    numberOfTestsDeclared,
+                              RunTest &        runTest,
+                              unsigned long    threadCount = 0) {
+        if (!threadCount) { threadCount = std::thread::hardware_concurrency(); }
+        if (!threadCount) { threadCount = 1; }
+
+        std::vector<Chunk> chunks;
+        unsigned long      waveSize     = CHUNK_SIZE * threadCount;
+        unsigned long      i            = 0;
+        bool               isEndOfInput = false;
+        for (unsigned long waveBegin = 0;
+             !isEndOfInput && (waveBegin < data.length());) {
+            unsigned long waveEnd = alignToLine(
+                    data, std::min(data.length(), waveBegin + waveSize));
+            std::string_view wave =
+                    data.substr(waveBegin, waveEnd - waveBegin);
+
+            chunks.resize(BasicAlgorithms::getChunkCount(wave.length(),
+                                                         threadCount));
+            BasicAlgorithms::parallelForEachChunk(
+                    wave.length(),
+                    [&](unsigned long chunkIndex, unsigned long begin,
+                        unsigned long end) {
+                        begin = alignToLine(wave, begin);
+                        end   = alignToLine(wave, end);
+                        parseChunk(wave.substr(begin, end - begin),
+                                   waveBegin + begin == 0, chunks[chunkIndex]);
+                    },
+                    threadCount);
+
+            for (Chunk &chunk : chunks) {
+                for (CommandDecoder::Command &test : chunk.commands) {
+                    if (i++ >= numberOfTestsDeclared) {
+
+                        // More "tests" than declared.
+                        throw std::runtime_error(Constants::WRONG_INPUT);
+                    }
+                    if (!runTest(test)) { return; }
+                }
+                if (chunk.isWrongInput) {
+                    throw std::runtime_error(Constants::WRONG_INPUT);
+                }
+                if (chunk.isEndOfInput) {
+                    isEndOfInput = true;
+                    break;
+                }
+            }
+            waveBegin = waveEnd;
+        }
+
+        if (i != numberOfTestsDeclared) {
+
+            // Less "tests" than declared.
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+    }
+
+  protected:
+    /**
+     * @return the offset of the start of the line that contains the given
+     *         @p offset of the @p data - or of the next line, in case the
+     *         @p offset is not at the start of a line already.
+     */
+    static unsigned long alignToLine(std::string_view data,
+                                     unsigned long    offset) {
+        if ((offset == 0) || (offset >= data.length())) { return offset; }
+
+        auto *found = (const char *) std::memchr(data.data() + offset - 1,
+                                                 Constants::NEW_LINE,
+                                                 data.length() - offset + 1);
+        return (found == nullptr) ? data.length() : found - data.data() + 1;
+    }
+
+  protected:
+    /**
+     * @brief Decodes all the lines of the given @p chunk to the
+     *        @p result - until an empty line, or a wrong line.
+     *
+     * @param isFirstTest whether the first line of the @p chunk is the first
+     *                    "test" of the input.
+     */
+    static void parseChunk(std::string_view chunk, bool isFirstTest,
+                           Chunk &result) {
+        result.commands.clear();
+        result.isEndOfInput = false;
+        result.isWrongInput = false;
+
+        CommandDecoder::Command test;
+        unsigned long           index = isFirstTest ? 0 : 1;
+        for (unsigned long lineBegin = 0; lineBegin < chunk.length();) {
+            auto *found = (const char *) std::memchr(
+                    chunk.data() + lineBegin, Constants::NEW_LINE,
+                    chunk.length() - lineBegin);
+            unsigned long lineEnd =
+                    (found == nullptr) ? chunk.length() : found - chunk.data();
+
+            std::string_view line =
+                    chunk.substr(lineBegin, lineEnd - lineBegin);
+            if (line.empty()) {
+                result.isEndOfInput = true;
+                return;
+            }
+            if (!CommandDecoder::tryDecode(line, index, test)) {
+                result.isWrongInput = true;
+                return;
+            }
+
+            result.commands.push_back(test);
+            index     = 1;
+            lineBegin = lineEnd + 1;
+        }
+    }
+};
+
+#endif // PARALLEL_COMMAND_PARSER_H
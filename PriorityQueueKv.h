@@ -5,6 +5,7 @@
 #include "DoublePointerMinHeapAndMaxHeapComponent.h"
 #include "Entry.h"
 #include "PriorityQueueKvAdt.h"
+#include "Tracepoints.h"
 
 /**
  * @brief This *priority-queue* is implemented by four *Heaps*, and each of
@@ -14,29 +15,67 @@
  *           The *priority* of each element is based on this comparable `key`.
  * @note `Entry<K, V>` will be also be referred as `E`.
  * @note `ElementInMinHeapAndMaxHeap<E>` will be also be referred as `EWrapper`.
+ * @tparam Allocator a std-allocator compatible allocator, that all the heaps,
+ *                   their arrays and their nodes are allocated with.
+ *                   For example, a `std::pmr::polymorphic_allocator` over a
+ *                   monotonic buffer or a per-thread arena.
  * @see DoublePointerMinHeapAndMaxHeapComponent
  * @see Entry
- * @version 2.0
+ * @see PRIORITY_QUEUE_KV_TRACE
+ * @version 2.5
  */
-template<typename K, typename V>
+template<typename K, typename V,
+         typename Allocator = std::allocator<Entry<K, V>>>
 class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
     typedef Entry<K, V> E;
 
     typedef ElementInMinHeapAndMaxHeap<E> EWrapper;
 
+    typedef DoublePointerMinHeapAndMaxHeapComponent<E, Allocator> DoubleHeap;
+
+    typedef typename DoubleHeap::EWrapperNodePool EWrapperNodePool;
+
+  public:
+    typedef typename PriorityQueueKvAdt<K, V>::Operation Operation;
+
+  public:
+    typedef typename PriorityQueueKvAdt<K, V>::OperationType OperationType;
+
   private:
     static constexpr unsigned long SIZE = 100;
 
   protected:
-    DoublePointerMinHeapAndMaxHeapComponent<E> *_lessOrEqualToMedianDoubleHeap =
-            nullptr;
+    /// The allocator that all the heaps and their nodes are allocated with.
+    Allocator _allocator;
 
   protected:
-    DoublePointerMinHeapAndMaxHeapComponent<E> *_greaterThanMedianDoubleHeap =
-            nullptr;
+    /**
+     * The pool that the nodes of *both* halves are allocated from, so that
+     * all of them can be released at once by `createEmpty()`.
+     */
+    EWrapperNodePool _nodePool;
+
+  protected:
+    DoubleHeap *_lessOrEqualToMedianDoubleHeap = nullptr;
+
+  protected:
+    DoubleHeap *_greaterThanMedianDoubleHeap = nullptr;
+
+  protected:
+    /**
+     * Counts the transfers between the two halves - only when built with
+     * `HEAP_STATISTICS`.
+     */
+#ifdef HEAP_STATISTICS
+    HeapStatisticsCounter _statisticsCounter;
+#else
+    static constexpr HeapStatisticsCounter _statisticsCounter {};
+#endif
 
   public:
-    explicit PriorityQueueKv(int physicalSizeOfEachHeap) {
+    explicit PriorityQueueKv(int              physicalSizeOfEachHeap,
+                             const Allocator &allocator = Allocator())
+        : _allocator(allocator), _nodePool(_allocator) {
         createDoubleHeapWithPhysicalSize(_lessOrEqualToMedianDoubleHeap,
                                          physicalSizeOfEachHeap);
         createDoubleHeapWithPhysicalSize(_greaterThanMedianDoubleHeap,
@@ -53,7 +92,8 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
      *          @li This kind of implementation is served only because of a
      *          request given by the customer ( = the course lecturer).
      */
-    PriorityQueueKv() {
+    explicit PriorityQueueKv(const Allocator &allocator = Allocator())
+        : _allocator(allocator), _nodePool(_allocator) {
         // createEmpty();
     }
 
@@ -62,8 +102,8 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
 
   protected:
     void deleteThis() const {
-        delete _lessOrEqualToMedianDoubleHeap;
-        delete _greaterThanMedianDoubleHeap;
+        BasicAllocations::destroy(_allocator, _lessOrEqualToMedianDoubleHeap);
+        BasicAllocations::destroy(_allocator, _greaterThanMedianDoubleHeap);
     }
 
   public:
@@ -107,13 +147,11 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
 
         /*
          * Extract the element via MOVE.
-         * `delete` the EWrapper which contains the `element` but not the
-         * `element` itself.
+         * Then, `delete` the EWrapper together with the moved-from `element`.
          */
-        EWrapper *eWrapper = maxEWrapper();
-        eWrapper->getUniqueElement()->setNeedToDeleteElement(false);
-        auto *element     = eWrapper->getUniqueElement()->getElement();
-        E     returnValue = *element;
+        EWrapper *eWrapper    = maxEWrapper();
+        auto *    element     = eWrapper->getUniqueElement()->getElement();
+        E         returnValue = (E &&) *element;
 
         if (getLogicalSize() >= 2) {
             _greaterThanMedianDoubleHeap
@@ -130,8 +168,9 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
                                                                           true);
         }
 
-        delete element;
-
+        PRIORITY_QUEUE_KV_TRACE(
+                delete_max, TraceArgument::of(returnValue.getKeyReference()),
+                getLogicalSize());
         return returnValue;
     }
 
@@ -171,13 +210,11 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
 
         /*
          * Extract the element via MOVE.
-         * `delete` the EWrapper which contains the `element` but not the
-         * `element` itself.
+         * Then, `delete` the EWrapper together with the moved-from `element`.
          */
-        EWrapper *eWrapper = minEWrapper();
-        eWrapper->getUniqueElement()->setNeedToDeleteElement(false);
-        auto *element     = eWrapper->getUniqueElement()->getElement();
-        E     returnValue = *element;
+        EWrapper *eWrapper    = minEWrapper();
+        auto *    element     = eWrapper->getUniqueElement()->getElement();
+        E         returnValue = (E &&) *element;
 
         if (getLogicalSize() >= 2) {
             _lessOrEqualToMedianDoubleHeap
@@ -194,50 +231,173 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
                                                                           true);
         }
 
-        delete element;
-
+        PRIORITY_QUEUE_KV_TRACE(
+                delete_min, TraceArgument::of(returnValue.getKeyReference()),
+                getLogicalSize());
         return returnValue;
     }
 
   public:
+    /**
+     * @brief creates this new empty data-structure.
+     *
+     * In case the data-structure was already created, it is *reset* instead:
+     * the arrays of the heaps and the `_nodePool` are kept for reuse, and all
+     * the nodes are released at once.
+     * @note The reset is `O(n)` for entries that need destruction, and `O(1)`
+     *       for *trivially destructible* entries.
+     * @see DoublePointerMinHeapAndMaxHeapComponent::makeEmpty()
+     * @see NodePool::release()
+     */
     void createEmpty() override {
-        createDoubleHeap(_lessOrEqualToMedianDoubleHeap);
-        createDoubleHeap(_greaterThanMedianDoubleHeap);
+        if (_lessOrEqualToMedianDoubleHeap == nullptr) {
+            createDoubleHeap(_lessOrEqualToMedianDoubleHeap);
+            createDoubleHeap(_greaterThanMedianDoubleHeap);
+            return;
+        }
+
+        _lessOrEqualToMedianDoubleHeap->makeEmpty();
+        _greaterThanMedianDoubleHeap->makeEmpty();
+        _nodePool.release();
     }
 
   protected:
-    void
-    createDoubleHeap(DoublePointerMinHeapAndMaxHeapComponent<E> *
-                             &fieldOfDoublePointerMinHeapAndMaxHeapComponent) {
-        auto *minHeap = new MinHeapWhenAlsoHavingMaxHeap<E>(SIZE);
-        auto *maxHeap = new MaxHeapWhenAlsoHavingMinHeap<E>(SIZE);
-
-        // Polymorphing `MinHeap` and `MaxHeap` through parameters.
-        fieldOfDoublePointerMinHeapAndMaxHeapComponent =
-                new DoublePointerMinHeapAndMaxHeapComponent<E>(minHeap,
-                                                               maxHeap);
+    void createDoubleHeap(
+            DoubleHeap *&fieldOfDoublePointerMinHeapAndMaxHeapComponent) {
+        createDoubleHeapWithPhysicalSize(
+                fieldOfDoublePointerMinHeapAndMaxHeapComponent, SIZE);
     }
 
   protected:
     void createDoubleHeapWithPhysicalSize(
-            DoublePointerMinHeapAndMaxHeapComponent<E> *
-                    &     fieldOfDoublePointerMinHeapAndMaxHeapComponent,
+            DoubleHeap *& fieldOfDoublePointerMinHeapAndMaxHeapComponent,
             unsigned long physicalSize) {
-        auto *minHeap = new MinHeapWhenAlsoHavingMaxHeap<E>(physicalSize);
-        auto *maxHeap = new MaxHeapWhenAlsoHavingMinHeap<E>(physicalSize);
 
-        // Polymorphing `MinHeap` and `MaxHeap` through parameters.
+        // Both halves share one allocator, as `EWrapper`s move between them.
         fieldOfDoublePointerMinHeapAndMaxHeapComponent =
-                new DoublePointerMinHeapAndMaxHeapComponent<E>(minHeap,
-                                                               maxHeap);
+                BasicAllocations::create<DoubleHeap>(_allocator, physicalSize,
+                                                     _allocator, &_nodePool);
     }
 
   public:
     void insert(K key, V value) override {
-        E element = Entry<K, V>(key, value);
+        insertElement(E((K &&) key, (V &&) value));
+    }
+
+  public:
+    /**
+     * @brief Applies the given @p operations by their order - as if each
+     *        of them was invoked by itself, but without a virtual call for
+     *        each of them:
+     * @li A run of consecutive `INSERT`s is inserted at once - see
+     *     @link insertAll @endlink.
+     * @li A run of queries (`MAX`, `MIN` and `MEDIAN`) between two
+     *     mutations is answered from the elements found by the first query
+     *     of each kind - *without* copying them.
+     *
+     * For example:
+     * @code
+     * Operation operations[3];
+     * operations[0].type = OperationType::CREATE_EMPTY;
+     * operations[1].type = OperationType::INSERT;
+     * operations[1].key  = 3;
+     * operations[2].type = OperationType::MEDIAN;
+     * priorityQueue.applyBatch(operations, 3, [](auto &&result) {
+     *     std::cout << result << std::endl; // 3
+     * });
+     * @endcode
+     *
+     * @param operations the operations to apply. The `value` of each
+     *                   `INSERT` is *moved* into this data-structure.
+     * @param onResult invoked with the result of each operation that has
+     *                 one, by their order - with a `const E &` to the
+     *                 element itself for a query, valid only until the next
+     *                 mutation, and with an `E &&` for a deleted element.
+     * @throws std::runtime_error the same as each method, in case of an
+     *         operation that fails - after the @p onResult was invoked with
+     *         the results of all the operations before it.
+     */
+    template<typename OnResult>
+    void applyBatch(Operation *operations, unsigned long count,
+                    OnResult &&onResult) {
+        const E *cachedMax    = nullptr;
+        const E *cachedMin    = nullptr;
+        const E *cachedMedian = nullptr;
+        for (unsigned long i = 0; i < count; i++) {
+            switch (operations[i].type) {
+                case OperationType::MAX:
+                    if (cachedMax == nullptr) {
+                        cachedMax =
+                                maxEWrapper()->getUniqueElement()->getElement();
+                    }
+                    onResult(*cachedMax);
+                    continue;
+                case OperationType::MIN:
+                    if (cachedMin == nullptr) {
+                        cachedMin =
+                                minEWrapper()->getUniqueElement()->getElement();
+                    }
+                    onResult(*cachedMin);
+                    continue;
+                case OperationType::MEDIAN:
+                    if (cachedMedian == nullptr) {
+                        cachedMedian = &medianElement();
+                    }
+                    onResult(*cachedMedian);
+                    continue;
+                case OperationType::DELETE_MAX:
+                    onResult(PriorityQueueKv::deleteMax());
+                    break;
+                case OperationType::DELETE_MIN:
+                    onResult(PriorityQueueKv::deleteMin());
+                    break;
+                case OperationType::CREATE_EMPTY:
+                    PriorityQueueKv::createEmpty();
+                    break;
+                case OperationType::INSERT: {
+                    unsigned long end = i + 1;
+                    while ((end < count) &&
+                           (operations[end].type == OperationType::INSERT)) {
+                        end++;
+                    }
+                    insertAll(operations + i, end - i);
+                    i = end - 1;
+                    break;
+                }
+            }
+
+            // A mutation - the elements found may not be the results anymore.
+            cachedMax    = nullptr;
+            cachedMin    = nullptr;
+            cachedMedian = nullptr;
+        }
+    }
+
+  public:
+    /**
+     * @brief Inserts the elements of all the given `INSERT` @p operations,
+     *        by their order.
+     *
+     * Each element is inserted exactly as by @link insert @endlink - so
+     * that elements of equal keys end up in the same order - but it is
+     * *moved* from its operation, and compared to the median in-place.
+     * @param operations `INSERT` operations. Their `value`s are *moved*.
+     */
+    void insertAll(Operation *operations, unsigned long count) {
+        for (unsigned long i = 0; i < count; i++) {
+            insertElement(E((K &&) operations[i].key,
+                            (V &&) operations[i].value));
+        }
+    }
+
+  protected:
+    void insertElement(E &&element) {
+        PRIORITY_QUEUE_KV_TRACE(insert,
+                                TraceArgument::of(element.getKeyReference()),
+                                getLogicalSize());
         if (getLogicalSize() > 0) {
             if (isLogicalSizeOdd()) {
-                if (median() < element) {
+                if (medianElement() < element) {
 
                     // Insert the given EWrapper to the "greater" heap.
                     _greaterThanMedianDoubleHeap->insertToBothHeaps(
@@ -250,7 +410,7 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
                             (E &&) element);
                 }
             } else if (isLogicalSizeEven()) {
-                if (median() < element) {
+                if (medianElement() < element) {
                     transferTheMinElementFromGreaterToLess();
 
                     // Insert the given EWrapper to the "greater" heap.
@@ -272,6 +432,8 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
 
   protected:
     void transferTheMaxElementFromLessToGreater() const {
+        _statisticsCounter.count(
+                &HeapStatistics::transferFromLessToGreaterCount);
         transferElementFromLessDoubleHeapViaIndexOfMaxHeapToGreaterDoubleHeap(
                 0);
     }
@@ -289,10 +451,13 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
         // Transfer it to both "greater" heaps.
         _greaterThanMedianDoubleHeap->insertToBothHeaps(
                 eWrapperToTransferToGreater);
+        traceRebalance(true, eWrapperToTransferToGreater);
     }
 
   protected:
     void transferTheMinElementFromGreaterToLess() const {
+        _statisticsCounter.count(
+                &HeapStatistics::transferFromGreaterToLessCount);
         transferElementFromGreaterDoubleHeapViaIndexOfMinHeapToLessDoubleHeap(
                 0);
     }
@@ -310,6 +475,21 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
         // Transfer it to both "less" heaps.
         _lessOrEqualToMedianDoubleHeap->insertToBothHeaps(
                 eWrapperToTransferToLess);
+        traceRebalance(false, eWrapperToTransferToLess);
+    }
+
+  private:
+    /// @brief Fires the `rebalance` tracepoint - see `Tracepoints.h`.
+    void traceRebalance(bool isLessToGreater, EWrapper *eWrapper) const {
+        PRIORITY_QUEUE_KV_TRACE(
+                rebalance, (int) isLessToGreater,
+                TraceArgument::of(eWrapper->getUniqueElement()
+                                          ->getElement()
+                                          ->getKeyReference()),
+                _lessOrEqualToMedianDoubleHeap->getMaxHeap()->getLogicalSize(),
+                _greaterThanMedianDoubleHeap->getMaxHeap()->getLogicalSize());
+        (void) isLessToGreater;
+        (void) eWrapper;
     }
 
   public:
@@ -319,7 +499,11 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
      *         `_lessOrEqualToMedianDoubleHeap`'s maximum-heap.
      *          This happens when `getLogicalSize() <= 0`.
      */
-    E median() override {
+    E median() override { return medianElement(); }
+
+  protected:
+    /// @return the median priority element itself - *without* copying it.
+    E &medianElement() {
 
         // DEVELOPER NOTE: this will always work when `getLogicalSize() > 0`
         return *(_lessOrEqualToMedianDoubleHeap->getMaxHeap()
@@ -328,6 +512,56 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
                          ->getElement());
     }
 
+  public:
+    /**
+     * @return the bytes held by this data-structure - by the arrays of its
+     *         heaps, including their slots not used, by the wrappers, the
+     *         `Unique`s and the entries of its elements, and by their keys and
+     *         values - for each of its two halves, and for what they share.
+     *         In `O(n)`.
+     * @see PriorityQueueKvMemoryUsage
+     */
+    PriorityQueueKvMemoryUsage memoryUsage() const {
+        PriorityQueueKvMemoryUsage memoryUsage;
+        unsigned long              usedBytes = 0;
+        if (_lessOrEqualToMedianDoubleHeap != nullptr) {
+            memoryUsage.lessOrEqualToMedian =
+                    _lessOrEqualToMedianDoubleHeap->getMemoryUsage();
+            memoryUsage.greaterThanMedian =
+                    _greaterThanMedianDoubleHeap->getMemoryUsage();
+            for (const MemoryUsage *half : {&memoryUsage.lessOrEqualToMedian,
+                                            &memoryUsage.greaterThanMedian}) {
+                usedBytes += half->wrapperBytes + half->uniqueBytes +
+                             half->entryBytes;
+            }
+        }
+
+        // The nodes of the pool in use are already counted by the halves.
+        unsigned long poolBytes = _nodePool.getAllocatedBytes();
+        memoryUsage.shared.otherBytes =
+                sizeof(*this) + poolBytes - std::min(poolBytes, usedBytes);
+        return memoryUsage;
+    }
+
+  public:
+    /**
+     * @brief The counters of the internal operations so far - of all the
+     *        heaps, of the transfers between the two halves, and of the
+     *        allocations of the nodes.
+     *
+     * @return all `0` unless built with `HEAP_STATISTICS` - see
+     *         `HeapStatistics`.
+     */
+    HeapStatistics getStatistics() const {
+        HeapStatistics statistics = _statisticsCounter.get();
+        statistics += _nodePool.getStatistics();
+        if (_lessOrEqualToMedianDoubleHeap != nullptr) {
+            statistics += _lessOrEqualToMedianDoubleHeap->getStatistics();
+            statistics += _greaterThanMedianDoubleHeap->getStatistics();
+        }
+        return statistics;
+    }
+
   protected:
     long int getLogicalSize() {
         return _lessOrEqualToMedianDoubleHeap->getMaxHeap()->getLogicalSize() +
@@ -359,8 +593,9 @@ class PriorityQueueKv : public PriorityQueueKvAdt<K, V> {
     }
 
   private:
-    static std::ostream &printThis(std::ostream &               os,
-                                   const PriorityQueueKv<K, V> &priorityQueue) {
+    static std::ostream &
+    printThis(std::ostream &                          os,
+              const PriorityQueueKv<K, V, Allocator> &priorityQueue) {
         constexpr char *PRINT_WHEN_EMPTY = (char *) "empty.";
 
         os << "---------------------------- ";
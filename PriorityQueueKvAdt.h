@@ -17,6 +17,34 @@
 template<typename K, typename V> class PriorityQueueKvAdt {
     typedef Entry<K, V> E;
 
+  public:
+    /// The type of an `Operation` - one per method of this interface.
+    enum class OperationType {
+        MAX,
+        DELETE_MAX,
+        MIN,
+        DELETE_MIN,
+        CREATE_EMPTY,
+        INSERT,
+        MEDIAN
+    };
+
+  public:
+    /**
+     * @brief A single invocation of a method of this interface - so that
+     *        a *batch* of invocations can be applied at once.
+     *
+     * @note the `key` and the `value` are used only by an `INSERT`.
+     */
+    struct Operation {
+
+        OperationType type = OperationType::CREATE_EMPTY;
+
+        K key {};
+
+        V value {};
+    };
+
   public:
     PriorityQueueKvAdt() = default;
 
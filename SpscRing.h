@@ -0,0 +1,159 @@
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief A bounded, *lock-free* queue between a *single* producer thread and
+ *        a *single* consumer thread - a ring-buffer of elements.
+ *
+ * The producer only writes the `_tail` index, and the consumer only writes
+ * the `_head` index - each on its own cache-line, so that the two threads do
+ * not contend on them. Each thread also keeps a *cached* copy of the other
+ * thread's index, and reloads it only when the ring seems full (or empty).
+ *
+ * For example:
+ * @code
+ * SpscRing<int>     ring(1024);
+ * std::atomic<bool> isAborted(false);
+ * std::thread consumer([&] {
+ *     int element;
+ *     while (ring.pop(element, isAborted) && element) { ... }
+ * });
+ * ring.push(1, isAborted);
+ * ring.push(0, isAborted);
+ * consumer.join();
+ * @endcode
+ *
+ * @tparam E the type of each element. **Must** be default-constructible and
+ *           move-assignable.
+ * @attention @link push @endlink must be called only by the producer thread,
+ *            and @link pop @endlink only by the consumer thread.
+ * @version 1.0
+ */
+template<typename E> class SpscRing {
+
+  protected:
+    static constexpr char *CAPACITY_MESSAGE =
+            (char *) "SpscRing: `capacity` must be a power of 2.";
+
+  protected:
+    /// The size of a cache-line, that the indexes are aligned to.
+    static constexpr unsigned long CACHE_LINE_SIZE = 64;
+
+  protected:
+    /// The amount of times to retry, before yielding the thread.
+    static constexpr unsigned long SPIN_COUNT = 64;
+
+  protected:
+    std::unique_ptr<E[]> _elements;
+
+  protected:
+    unsigned long _capacity = 0;
+
+  protected:
+    /// The index of the next element to pop. Written by the consumer.
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned long> _head{0};
+
+  protected:
+    /// The consumer's copy of the `_tail` - on the consumer's cache-line.
+    unsigned long _cachedTail = 0;
+
+  protected:
+    /// The index of the next element to push. Written by the producer.
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned long> _tail{0};
+
+  protected:
+    /// The producer's copy of the `_head` - on the producer's cache-line.
+    unsigned long _cachedHead = 0;
+
+  public:
+    /**
+     * @param capacity the maximum amount of elements in the ring. **Must**
+     *                 be a power of `2`.
+     */
+    explicit SpscRing(unsigned long capacity)
+        : _elements(new E[capacity]), _capacity(capacity) {
+        if (!capacity || (capacity & (capacity - 1))) {
+            throw std::invalid_argument(CAPACITY_MESSAGE);
+        }
+    }
+
+  public:
+    SpscRing(const SpscRing &other) = delete;
+
+  public:
+    SpscRing &operator=(const SpscRing &other) = delete;
+
+  public:
+    /**
+     * @brief Pushes the given @p element, *if* the ring is not full.
+     * @return `true` if the @p element was pushed. Else, `false`.
+     */
+    bool tryPush(E &&element) {
+        unsigned long tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead == _capacity) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead == _capacity) { return false; }
+        }
+
+        _elements[tail & (_capacity - 1)] = (E &&) element;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Pops the next element, *if* the ring is not empty.
+     * @return `true` if an element was popped to @p element. Else, `false`.
+     */
+    bool tryPop(E &element) {
+        unsigned long head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail) { return false; }
+        }
+
+        element = (E &&) _elements[head & (_capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Pushes the given @p element - waiting while the ring is full.
+     *
+     * @param isAborted the waiting is given up once it is `true`.
+     * @return `true` if the @p element was pushed. `false` if the waiting was
+     *         given up.
+     */
+    bool push(E &&element, const std::atomic<bool> &isAborted) {
+        for (unsigned long spin = 0; !tryPush((E &&) element); spin++) {
+            if (isAborted.load(std::memory_order_relaxed)) { return false; }
+            if (spin >= SPIN_COUNT) { std::this_thread::yield(); }
+        }
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Pops the next element - waiting while the ring is empty.
+     *
+     * @param isAborted the waiting is given up once it is `true`.
+     * @return `true` if an element was popped to @p element. `false` if the
+     *         waiting was given up.
+     */
+    bool pop(E &element, const std::atomic<bool> &isAborted) {
+        for (unsigned long spin = 0; !tryPop(element); spin++) {
+            if (isAborted.load(std::memory_order_relaxed)) { return false; }
+            if (spin >= SPIN_COUNT) { std::this_thread::yield(); }
+        }
+        return true;
+    }
+};
+
+#endif // SPSC_RING_H
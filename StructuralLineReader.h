@@ -0,0 +1,199 @@
+
+#ifndef STRUCTURAL_LINE_READER_H
+#define STRUCTURAL_LINE_READER_H
+
+#include "LineReaderAdt.h"
+#include "StructuralScanner.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+/**
+ * @brief This class reads lines out of a *whole* input that is already in
+ *        memory (for example, a `MappedFile`), by a *structural index* of
+ *        it.
+ *
+ * The input is indexed a block at a time by the `StructuralScanner`, which
+ * finds all of the `Constants::NEW_LINE` and ' ' chars in the block at once.
+ * Each line is then cut at the next `Constants::NEW_LINE` in the index, and
+ * the ' ' chars in the index *within* the line give its
+ * @link getKeyEnd @endlink - so that the `CommandDecoder` does not need to
+ * scan the line for it again.
+ *
+ * For example:
+ * @code
+ * MappedFile file("commands.txt");
+ * StructuralLineReader reader(file.getView());
+ * std::string_view line;
+ * while (reader.getLine(line)) {
+ *     CommandDecoder::decode(line, i++, command, reader.getKeyEnd());
+ * }
+ * @endcode
+ *
+ * @note a line returned views the input given - so it remains valid as long
+ *       as the input is.
+ * @version 1.0
+ */
+class StructuralLineReader : public LineReaderAdt {
+
+  public:
+    /// The size of each block indexed at once, in bytes.
+    static constexpr unsigned long BLOCK_SIZE = 1UL << 20;
+
+  protected:
+    /// The whole input.
+    std::string_view _data;
+
+  protected:
+    /// The bit-map of the `Constants::NEW_LINE` chars in the current block.
+    std::unique_ptr<std::uint64_t[]> _newLineBits;
+
+  protected:
+    /// The bit-map of the ' ' chars in the current block.
+    std::unique_ptr<std::uint64_t[]> _delimiterBits;
+
+  protected:
+    /// The offset of the current block in the `_data`.
+    unsigned long _blockBegin = 0;
+
+  protected:
+    /// The offset of the end of the current block in the `_data`.
+    unsigned long _blockEnd = 0;
+
+  protected:
+    /// The offset of the next line in the `_data`.
+    unsigned long _lineBegin = 0;
+
+  protected:
+    /// @see getKeyEnd
+    unsigned long _keyEnd = std::string_view::npos;
+
+  public:
+    /// @param data the whole input to read the lines of.
+    explicit StructuralLineReader(std::string_view data)
+        : _data(data),
+          _newLineBits(new std::uint64_t[StructuralScanner::getWordCount(
+                  BLOCK_SIZE)]),
+          _delimiterBits(new std::uint64_t[StructuralScanner::getWordCount(
+                  BLOCK_SIZE)]) {}
+
+  public:
+    /**
+     * @return the index of the first ' ' char *after* the first two chars
+     *         of the last line gotten - where the *key* of an `f` line ends.
+     *         `std::string_view::npos` in case there is no such char.
+     * @see CommandDecoder::tryDecode
+     */
+    unsigned long getKeyEnd() const { return _keyEnd; }
+
+  public:
+    /**
+     * @note Only the `Constants::NEW_LINE` char is *indexed* - any other
+     *       @p endingChar is searched for without the index.
+     */
+    bool getLine(std::string_view &line,
+                 char              endingChar = Constants::NEW_LINE) override {
+        _keyEnd = std::string_view::npos;
+        if (_lineBegin >= _data.length()) {
+            line = std::string_view();
+            return false;
+        }
+        if (endingChar != Constants::NEW_LINE) {
+            return getLineWithoutIndex(line, endingChar);
+        }
+
+        unsigned long from = _lineBegin;
+        while (from < _data.length()) {
+            if ((from < _blockBegin) || (_blockEnd <= from)) {
+                indexBlockOf(from);
+            }
+
+            unsigned long lineEnd =
+                    findBit(_newLineBits.get(), from, _blockEnd);
+            if (_keyEnd == std::string_view::npos) {
+                findKeyEnd(std::max(from, _lineBegin + 2),
+                           lineEnd == std::string_view::npos ? _blockEnd
+                                                             : lineEnd);
+            }
+            if (lineEnd != std::string_view::npos) {
+                line       = _data.substr(_lineBegin, lineEnd - _lineBegin);
+                _lineBegin = lineEnd + 1;
+                return true;
+            }
+
+            // The line continues in the next block.
+            from = _blockEnd;
+        }
+
+        // The last line does not end with a `Constants::NEW_LINE`.
+        line       = _data.substr(_lineBegin);
+        _lineBegin = _data.length();
+        return true;
+    }
+
+  protected:
+    /**
+     * @brief Sets the `_keyEnd` to the first ' ' char in the range
+     *        `[from, to)` of the current block - if there is one.
+     */
+    void findKeyEnd(unsigned long from, unsigned long to) {
+        if (from >= to) { return; }
+
+        unsigned long keyEnd = findBit(_delimiterBits.get(), from, to);
+        if (keyEnd != std::string_view::npos) { _keyEnd = keyEnd - _lineBegin; }
+    }
+
+  protected:
+    /**
+     * @brief Finds the first bit set in the given bit-map of the current
+     *        block, in the range `[from, to)` of the `_data`.
+     * @return the offset in the `_data` of the bit found.
+     *         `std::string_view::npos` in case there is no such bit.
+     */
+    unsigned long findBit(const std::uint64_t *bits, unsigned long from,
+                          unsigned long to) const {
+        constexpr unsigned long BITS_PER_WORD =
+                StructuralScanner::BITS_PER_WORD;
+
+        unsigned long index = from - _blockBegin;
+        unsigned long end   = to - _blockBegin;
+        unsigned long word  = index / BITS_PER_WORD;
+
+        // Ignore the bits before the `from` offset.
+        std::uint64_t bitsOfWord =
+                bits[word] & (~(std::uint64_t) 0 << (index % BITS_PER_WORD));
+        while (!bitsOfWord) {
+            if (++word * BITS_PER_WORD >= end) {
+                return std::string_view::npos;
+            }
+            bitsOfWord = bits[word];
+        }
+
+        unsigned long found =
+                word * BITS_PER_WORD + __builtin_ctzll(bitsOfWord);
+        return found < end ? _blockBegin + found : std::string_view::npos;
+    }
+
+  protected:
+    /// @brief Indexes the block that contains the given @p offset.
+    void indexBlockOf(unsigned long offset) {
+        _blockBegin = offset - offset % BLOCK_SIZE;
+        _blockEnd   = std::min(_blockBegin + BLOCK_SIZE, _data.length());
+        StructuralScanner::scan(_data.data() + _blockBegin,
+                                _blockEnd - _blockBegin, _newLineBits.get(),
+                                _delimiterBits.get());
+    }
+
+  protected:
+    bool getLineWithoutIndex(std::string_view &line, char endingChar) {
+        unsigned long lineEnd = _data.find(endingChar, _lineBegin);
+        if (lineEnd == std::string_view::npos) { lineEnd = _data.length(); }
+
+        line       = _data.substr(_lineBegin, lineEnd - _lineBegin);
+        _lineBegin = lineEnd + 1;
+        return true;
+    }
+};
+
+#endif // STRUCTURAL_LINE_READER_H
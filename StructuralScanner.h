@@ -0,0 +1,203 @@
+
+#ifndef STRUCTURAL_SCANNER_H
+#define STRUCTURAL_SCANNER_H
+
+#include "Constants.h"
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define STRUCTURAL_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief This class finds all the *structural* chars of the input - the
+ *        `Constants::NEW_LINE` chars that end the lines, and the ' ' chars
+ *        that separate the parameters - in a whole block at once.
+ *
+ * The block is compared against both chars a *vector* at a time, and the
+ * result is kept as two *bit-maps* - a bit for each byte of the block:
+ * @li With *AVX2* - 32 bytes at a time, when the CPU supports it.
+ * @li With *SSE2* - 16 bytes at a time, on any other x86 CPU.
+ * @li With a *scalar* loop - a byte at a time, on any other CPU.
+ *
+ * The instruction-set is picked once, at run-time.
+ *
+ * For example:
+ * @code
+ * std::uint64_t newLineBits[1], delimiterBits[1];
+ * StructuralScanner::scan("f 3 hi\ng\n", 9, newLineBits, delimiterBits);
+ * // newLineBits[0] == 0b101000000, delimiterBits[0] == 0b1010
+ * @endcode
+ *
+ * @version 1.0
+ */
+class StructuralScanner {
+
+  public:
+    /// The char that separates the letter and the parameters of a line.
+    static constexpr char DELIMITER = ' ';
+
+  public:
+    /// The amount of bytes that each word of a bit-map stands for.
+    static constexpr unsigned long BITS_PER_WORD = 64;
+
+  public:
+    /**
+     * @brief A function that scans a block.
+     * @see scan
+     */
+    typedef void (*ScanFunction)(const char *data, unsigned long size,
+                                 std::uint64_t *newLineBits,
+                                 std::uint64_t *delimiterBits);
+
+  public:
+    /**
+     * @brief Finds all the `Constants::NEW_LINE` and `DELIMITER` chars in
+     *        the given block.
+     *
+     * Bit `i % 64` of word `i / 64` of each bit-map is set, if byte `i` of
+     * the block is the char of that bit-map.
+     * @param data the block to scan.
+     * @param size the size of the block.
+     * @param newLineBits the bit-map of the `Constants::NEW_LINE` chars.
+     *                    **Must** be able to hold @link getWordCount
+     *                    @endlink words.
+     * @param delimiterBits the bit-map of the `DELIMITER` chars. **Must** be
+     *                      able to hold @link getWordCount @endlink words.
+     */
+    static void scan(const char *data, unsigned long size,
+                     std::uint64_t *newLineBits, std::uint64_t *delimiterBits) {
+        getScanFunction()(data, size, newLineBits, delimiterBits);
+    }
+
+  public:
+    /// @return the amount of words in a bit-map of a block of @p size bytes.
+    static unsigned long getWordCount(unsigned long size) {
+        return (size + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    }
+
+  public:
+    /// @return the name of the instruction-set that @link scan @endlink uses.
+    static const char *getInstructionSetName() {
+        ScanFunction scanFunction = getScanFunction();
+#ifdef STRUCTURAL_SCANNER_X86
+        if (scanFunction == &scanAvx2) { return "avx2"; }
+        if (scanFunction == &scanSse2) { return "sse2"; }
+#endif
+        return scanFunction == &scanScalar ? "scalar" : "unknown";
+    }
+
+  public:
+    /// @brief The *scalar* version of @link scan @endlink.
+    static void scanScalar(const char *data, unsigned long size,
+                           std::uint64_t *newLineBits,
+                           std::uint64_t *delimiterBits) {
+        scanScalarFrom(data, 0, size, newLineBits, delimiterBits);
+    }
+
+#ifdef STRUCTURAL_SCANNER_X86
+  public:
+    /// @brief The *SSE2* version of @link scan @endlink.
+    __attribute__((target("sse2"))) static void
+    scanSse2(const char *data, unsigned long size, std::uint64_t *newLineBits,
+             std::uint64_t *delimiterBits) {
+        const __m128i newLines   = _mm_set1_epi8(Constants::NEW_LINE);
+        const __m128i delimiters = _mm_set1_epi8(DELIMITER);
+
+        unsigned long i = 0;
+        for (; i + BITS_PER_WORD <= size; i += BITS_PER_WORD) {
+            std::uint64_t newLineWord   = 0;
+            std::uint64_t delimiterWord = 0;
+            for (unsigned long j = 0; j < BITS_PER_WORD; j += 16) {
+                __m128i block =
+                        _mm_loadu_si128((const __m128i *) (data + i + j));
+                std::uint64_t newLineMask = (std::uint16_t) _mm_movemask_epi8(
+                        _mm_cmpeq_epi8(block, newLines));
+                std::uint64_t delimiterMask =
+                        (std::uint16_t) _mm_movemask_epi8(
+                                _mm_cmpeq_epi8(block, delimiters));
+                newLineWord |= newLineMask << j;
+                delimiterWord |= delimiterMask << j;
+            }
+            newLineBits[i / BITS_PER_WORD]   = newLineWord;
+            delimiterBits[i / BITS_PER_WORD] = delimiterWord;
+        }
+        scanScalarFrom(data, i, size, newLineBits, delimiterBits);
+    }
+
+  public:
+    /// @brief The *AVX2* version of @link scan @endlink.
+    __attribute__((target("avx2"))) static void
+    scanAvx2(const char *data, unsigned long size, std::uint64_t *newLineBits,
+             std::uint64_t *delimiterBits) {
+        const __m256i newLines   = _mm256_set1_epi8(Constants::NEW_LINE);
+        const __m256i delimiters = _mm256_set1_epi8(DELIMITER);
+
+        unsigned long i = 0;
+        for (; i + BITS_PER_WORD <= size; i += BITS_PER_WORD) {
+            __m256i low  = _mm256_loadu_si256((const __m256i *) (data + i));
+            __m256i high =
+                    _mm256_loadu_si256((const __m256i *) (data + i + 32));
+            newLineBits[i / BITS_PER_WORD] =
+                    toWord(_mm256_movemask_epi8(
+                                   _mm256_cmpeq_epi8(low, newLines)),
+                           _mm256_movemask_epi8(
+                                   _mm256_cmpeq_epi8(high, newLines)));
+            delimiterBits[i / BITS_PER_WORD] =
+                    toWord(_mm256_movemask_epi8(
+                                   _mm256_cmpeq_epi8(low, delimiters)),
+                           _mm256_movemask_epi8(
+                                   _mm256_cmpeq_epi8(high, delimiters)));
+        }
+        scanScalarFrom(data, i, size, newLineBits, delimiterBits);
+    }
+
+  protected:
+    /// @return a word of the bit-map, out of two halves of 32 bits.
+    static std::uint64_t toWord(int lowMask, int highMask) {
+        return (std::uint64_t) (std::uint32_t) lowMask |
+               ((std::uint64_t) (std::uint32_t) highMask << 32);
+    }
+#endif
+
+  protected:
+    /**
+     * @brief Scans the block from the index @p from, a byte at a time.
+     *
+     * @param from the index to scan from. **Must** be the first byte of a
+     *             word of the bit-maps.
+     */
+    static void scanScalarFrom(const char *data, unsigned long from,
+                               unsigned long size, std::uint64_t *newLineBits,
+                               std::uint64_t *delimiterBits) {
+        for (unsigned long i = from; i < size; i++) {
+            unsigned long word = i / BITS_PER_WORD;
+            std::uint64_t bit  = (std::uint64_t) 1 << (i % BITS_PER_WORD);
+            if (i % BITS_PER_WORD == 0) {
+                newLineBits[word]   = 0;
+                delimiterBits[word] = 0;
+            }
+            if (data[i] == Constants::NEW_LINE) { newLineBits[word] |= bit; }
+            if (data[i] == DELIMITER) { delimiterBits[word] |= bit; }
+        }
+    }
+
+  protected:
+    static ScanFunction getScanFunction() {
+        static const ScanFunction scanFunction = pickScanFunction();
+        return scanFunction;
+    }
+
+  protected:
+    static ScanFunction pickScanFunction() {
+#ifdef STRUCTURAL_SCANNER_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) { return &scanAvx2; }
+        if (__builtin_cpu_supports("sse2")) { return &scanSse2; }
+#endif
+        return &scanScalar;
+    }
+};
+
+#endif // STRUCTURAL_SCANNER_H
@@ -2,10 +2,25 @@
 #ifndef TEST_RUNNER_H
 #define TEST_RUNNER_H
 
+#include "AsyncFileReader.h"
+#include "BasicAlgorithms.h"
+#include "BinaryProtocol.h"
+#include "BufferedReader.h"
+#include "CommandDecoder.h"
+#include "CommandStatistics.h"
 #include "Entry.h"
 #include "Input.h"
+#include "MappedFile.h"
+#include "OutputWriter.h"
+#include "ParallelCommandParser.h"
 #include "PriorityQueueKv.h"
+#include "SpscRing.h"
+#include "StructuralLineReader.h"
+#include <atomic>
+#include <exception>
 #include <string>
+#include <thread>
+#include <unistd.h>
 
 /**
  * @brief This class bundles all the requests to receive inputs from the
@@ -15,10 +30,372 @@
 class TestRunner {
 
   public:
+    /// How to run the "tests".
+    struct Options {
+
+        /**
+         * Whether to run the "tests" in a *pipeline* of 3 threads - one
+         * parsing them, one executing them, and one writing their results.
+         * @see runAllTestsPipelined
+         */
+        bool isPipelined = false;
+
+        /// Whether to pin each thread of the pipeline to its own CPU.
+        bool isPinned = false;
+
+        /**
+         * Whether to parse the "tests" of a *mapped* text file on multiple
+         * threads at once. Ignored when there is only a single hardware
+         * thread available.
+         * @see ParallelCommandParser
+         */
+        bool isParsedInParallel = false;
+
+        /**
+         * Whether to read a regular file in blocks that are read *ahead*
+         * asynchronously - instead of mapping it to memory.
+         * @see AsyncFileReader
+         */
+        bool isReadAsynchronously = false;
+
+        /**
+         * Whether to read the lines of a *mapped* text file by a
+         * *structural index* of it - instead of searching each line end by
+         * `memchr`, which is faster on most inputs.
+         * @see StructuralLineReader
+         */
+        bool isStructurallyIndexed = false;
+
+        /**
+         * The statistics to record the latencies of the "tests" to - or
+         * `nullptr`, to not record them. Not owned.
+         * @attention while recording, the "tests" are run *serially*, one at
+         *            a time - regardless of `isPipelined`.
+         * @see runAllTestsWithStatistics
+         */
+        CommandStatistics *statistics = nullptr;
+    };
+
+  public:
+    /// The capacity of each ring-buffer between the threads of the pipeline.
+    static constexpr unsigned long PIPELINE_RING_CAPACITY = 1024;
+
+  public:
+    /**
+     * The maximum amount of "tests" that are applied to the
+     * `PriorityQueueKv` at once.
+     * @see PriorityQueueKv::applyBatch
+     */
+    static constexpr unsigned long BATCH_SIZE = 256;
+
+  private:
+    typedef PriorityQueueKv<int, std::string>::Operation Operation;
+
+  private:
+    typedef PriorityQueueKv<int, std::string>::OperationType OperationType;
+
+  public:
+    /// @brief Gets the "tests" from the standard input, and run them.
     static void getTestArrayAndRunAllTests() {
+        getTestArrayAndRunAllTests(Options());
+    }
+
+  public:
+    /// @brief Gets the "tests" from the file in the given @p path, and run
+    ///        them.
+    static void getTestArrayAndRunAllTestsFromFile(const std::string &path) {
+        getTestArrayAndRunAllTestsFromFile(path, Options());
+    }
+
+  public:
+    /**
+     * @brief Gets the "tests" from the standard input, and run them.
+     *
+     * The "tests" may be either in the text format, or in the *binary*
+     * format of the `BinaryProtocol` - which is told by their first byte.
+     * @param options how to run the "tests".
+     */
+    static void getTestArrayAndRunAllTests(const Options &options) {
+        BufferedReader reader(STDIN_FILENO);
+        getTextOrBinaryTestArrayAndRunAllTests(reader, options);
+    }
+
+  public:
+    /**
+     * @brief Gets the "tests" from the file in the given @p path, and run
+     *        them.
+     *
+     * A regular file is *mapped* to memory, and its lines - or its *binary*
+     * commands - are read *in-place*. With `Options::isStructurallyIndexed`,
+     * the lines are read by a *structural index* of it. Any other file (for
+     * example, a pipe) is read the same way the standard input is read.
+     *
+     * With `Options::isReadAsynchronously`, a regular file is read in
+     * blocks that are read ahead instead - see `AsyncFileReader`.
+     * @param path the path of the file to get the "tests" from.
+     * @param options how to run the "tests".
+     * @throws std::runtime_error in case the file could not be opened.
+     * @see MappedFile
+     * @see StructuralLineReader
+     */
+    static void
+    getTestArrayAndRunAllTestsFromFile(const std::string &path,
+                                       const Options &    options) {
+        if (options.isReadAsynchronously) {
+            AsyncFileReader file(path);
+            if (file.isRegularFile()) {
+                getTextOrBinaryTestArrayAndRunAllTests(file, options);
+            } else {
+                BufferedReader reader(file.getFd());
+                getTextOrBinaryTestArrayAndRunAllTests(reader, options);
+            }
+            return;
+        }
+
+        MappedFile file(path);
+        char       firstByte = 0;
+        if (file.isMapped() && file.peekByte(firstByte) &&
+            BinaryProtocol::isBinaryCommands(firstByte)) {
+            getBinaryTestArrayAndRunAllTests(file, options);
+        } else if (file.isMapped() && options.isParsedInParallel &&
+                   (std::thread::hardware_concurrency() > 1)) {
+            getTestArrayAndRunAllTestsInParallel(file.getView(), options);
+        } else if (file.isMapped() && options.isStructurallyIndexed) {
+            StructuralLineReader reader(file.getView());
+            getTestArrayAndRunAllTests(reader, options);
+        } else if (file.isMapped()) {
+            getTestArrayAndRunAllTests(file, options);
+        } else {
+            BufferedReader reader(file.getFd());
+            getTestArrayAndRunAllTests(reader, options);
+        }
+    }
+
+  private:
+    /**
+     * @brief Gets the "tests" from the @p reader, and run them - either in
+     *        the text format, or in the *binary* format of the
+     *        `BinaryProtocol`, which is told by their first byte.
+     */
+    static void getTextOrBinaryTestArrayAndRunAllTests(BufferedReader &reader,
+                                                       const Options &options) {
+        char firstByte = 0;
+        if (reader.peekByte(firstByte) &&
+            BinaryProtocol::isBinaryCommands(firstByte)) {
+            getBinaryTestArrayAndRunAllTests(reader, options);
+        } else {
+            getTestArrayAndRunAllTests(reader, options);
+        }
+    }
+
+  private:
+    /**
+     * @brief Gets the "tests" from the @p reader, and run them.
+     *
+     * The results are written to the standard output through an
+     * `OutputWriter` - flushed at the end of each line only when the
+     * standard output is a terminal. In case of a wrong input, the results
+     * before it are flushed by the writer's destructor, *before* `main`
+     * prints the error.
+     */
+    template<typename Reader>
+    static void getTestArrayAndRunAllTests(Reader &       reader,
+                                           const Options &options) {
+        OutputWriter writer(STDOUT_FILENO,
+                            OutputWriter::getDefaultFlushPolicy(STDOUT_FILENO));
+        unsigned long numberOfTestsDeclared =
+                CommandDecoder::decodeNumberOfCommands(Input::getLine(reader));
+        runAllTests(
+                writer, false, options, getMaximumBatchSize(reader, writer),
+                [&] { return hasBufferedInput(reader); },
+                [&](auto &&runTest) {
+                    parseAllTests(reader, numberOfTestsDeclared, runTest);
+                });
+        writer.flush();
+    }
+
+  private:
+    /**
+     * @brief Gets the "tests" from the given *whole* @p data, and run them -
+     *        the same as @link getTestArrayAndRunAllTests @endlink, with the
+     *        "tests" parsed on multiple threads at once.
+     * @see ParallelCommandParser
+     */
+    static void getTestArrayAndRunAllTestsInParallel(std::string_view data,
+                                                     const Options &  options) {
+        OutputWriter writer(STDOUT_FILENO,
+                            OutputWriter::getDefaultFlushPolicy(STDOUT_FILENO));
+        unsigned long lineEnd = data.find(Constants::NEW_LINE);
         unsigned long numberOfTestsDeclared =
-                Input::getValidNumberOfTestsDeclared();
-        runAllTests(numberOfTestsDeclared);
+                CommandDecoder::decodeNumberOfCommands(data.substr(0, lineEnd));
+        std::string_view tests = (lineEnd == std::string_view::npos)
+                                         ? std::string_view()
+                                         : data.substr(lineEnd + 1);
+
+        runAllTests(
+                writer, false, options, BATCH_SIZE, [] { return true; },
+                [&](auto &&runTest) {
+                    ParallelCommandParser::parseAllTests(
+                            tests, numberOfTestsDeclared, runTest);
+                });
+        writer.flush();
+    }
+
+  private:
+    /**
+     * @brief Gets the *binary* "tests" from the @p reader, and run them.
+     *
+     * The results are written to the standard output in the *binary*
+     * format as well. In case of a wrong input, the results stream is ended
+     * with the `BinaryProtocol::ERROR_TAG`.
+     * @throws BinaryProtocol::ErrorWritten in case of a wrong input.
+     * @see BinaryProtocol
+     */
+    template<typename ByteReader>
+    static void getBinaryTestArrayAndRunAllTests(ByteReader &   reader,
+                                                 const Options &options) {
+        OutputWriter writer(STDOUT_FILENO);
+        BinaryProtocol::writeHeader(writer, BinaryProtocol::RESULTS_MAGIC);
+        try {
+            BinaryProtocol::readHeader(reader,
+                                       BinaryProtocol::COMMANDS_MAGIC);
+            unsigned long numberOfTestsDeclared =
+                    BinaryProtocol::readNumberOfCommands(reader);
+            runAllTests(
+                    writer, true, options,
+                    getMaximumBatchSize(reader, writer),
+                    [&] { return hasBufferedInput(reader); },
+                    [&](auto &&runTest) {
+                        parseAllBinaryTests(reader, numberOfTestsDeclared,
+                                            runTest);
+                    });
+        } catch (std::exception &e) {
+            BinaryProtocol::writeError(writer);
+            writer.flush();
+            throw BinaryProtocol::ErrorWritten();
+        }
+        writer.flush();
+    }
+
+  private:
+    /**
+     * @brief Runs all the "tests" that the given @p parseAllTests function
+     *        parses - either *serially*, or in a *pipeline*.
+     *
+     * The "tests" are applied to the `PriorityQueueKv` in batches of up to
+     * `BATCH_SIZE` - see `PriorityQueueKv::applyBatch`. A batch is applied
+     * early, once there is no more input buffered - so that the results of
+     * the "tests" are never held back while waiting for the input. In case
+     * of a wrong input, the batch of the "tests" before it is applied first.
+     * @param writer the writer to write the results of the "tests" to.
+     * @param isBinary whether to write the results in the *binary* format.
+     * @param options how to run the "tests".
+     * @param maximumBatchSize the maximum amount of "tests" in a batch - see
+     *                         @link getMaximumBatchSize @endlink.
+     * @param hasBufferedInput a function that returns whether there are more
+     *                         "tests" to parse *without* waiting for the
+     *                         input.
+     * @param parseAllTests a function that is invoked with a `runTest`
+     *                      function, and invokes it on each "test" parsed -
+     *                      until it returns `false`.
+     * @see parseAllTests
+     */
+    template<typename HasBufferedInput, typename ParseAllTests>
+    static void runAllTests(OutputWriter &writer, bool isBinary,
+                            const Options &     options,
+                            unsigned long       maximumBatchSize,
+                            HasBufferedInput && hasBufferedInput,
+                            ParseAllTests &&    parseAllTests) {
+        if (options.statistics != nullptr) {
+            runAllTestsWithStatistics(writer, isBinary, *options.statistics,
+                                      parseAllTests);
+            return;
+        }
+        if (options.isPipelined) {
+            runAllTestsPipelined(writer, isBinary, options.isPinned,
+                                 parseAllTests);
+            return;
+        }
+
+        PriorityQueueKv<int, std::string> priorityQueueKv;
+        std::unique_ptr<Operation[]>      batch(new Operation[BATCH_SIZE]);
+        unsigned long                     batchSize = 0;
+
+        // The batch is emptied *before* it is applied, so that a failed
+        // batch is not applied again.
+        auto applyBatch = [&] {
+            unsigned long count = batchSize;
+            batchSize           = 0;
+            priorityQueueKv.applyBatch(
+                    batch.get(), count, [&](const auto &result) {
+                        writeResult(writer, result, isBinary);
+                    });
+        };
+
+        try {
+            parseAllTests([&](CommandDecoder::Command &test) {
+                toOperation(test, test.value, batch[batchSize++]);
+                if ((batchSize == maximumBatchSize) || !hasBufferedInput()) {
+                    applyBatch();
+                }
+                return true;
+            });
+        } catch (std::exception &e) {
+
+            // The "tests" before the wrong input are still run.
+            applyBatch();
+            throw;
+        }
+        applyBatch();
+    }
+
+  private:
+    /**
+     * @brief Runs all the "tests" that the given @p parseAllTests function
+     *        parses - one at a time, while recording to the given
+     *        @p statistics how long each of them took to be parsed, to be
+     *        executed, and to have its result written.
+     *
+     * The time of writing a result is *not* included in the time of
+     * executing its "test".
+     * @see runAllTests
+     */
+    template<typename ParseAllTests>
+    static void runAllTestsWithStatistics(OutputWriter &     writer,
+                                          bool               isBinary,
+                                          CommandStatistics &statistics,
+                                          ParseAllTests &&   parseAllTests) {
+        typedef CommandStatistics::Clock Clock;
+
+        PriorityQueueKv<int, std::string> priorityQueueKv;
+        Operation                         operation;
+        Clock::time_point                 parseStart = Clock::now();
+        try {
+            parseAllTests([&](CommandDecoder::Command &test) {
+                Clock::time_point executeStart = Clock::now();
+                statistics.recordParsing(executeStart - parseStart);
+
+                Clock::duration outputDuration {};
+                toOperation(test, test.value, operation);
+                priorityQueueKv.applyBatch(
+                        &operation, 1, [&](const auto &result) {
+                            Clock::time_point outputStart = Clock::now();
+                            writeResult(writer, result, isBinary);
+                            outputDuration = Clock::now() - outputStart;
+                            statistics.recordOutput(outputDuration);
+                        });
+
+                parseStart = Clock::now();
+                statistics.recordExecution(
+                        test.opcode,
+                        parseStart - executeStart - outputDuration);
+                return true;
+            });
+        } catch (std::exception &e) {
+            statistics.setHeapStatistics(priorityQueueKv.getStatistics());
+            throw;
+        }
+        statistics.setHeapStatistics(priorityQueueKv.getStatistics());
     }
 
   private:
@@ -38,24 +415,26 @@ class TestRunner {
      * f 7 day hello hey
      * g
      * @endcode
+     * @param reader the reader to get the "tests" from.
      * @param numberOfTestsDeclared the amount of "tests" declared by the
      *                              user, received before calling this function.
+     * @param runTest a function that runs each "test" parsed. Returns `false`
+     *                in case the "tests" after it should not be parsed.
      */
-    static void runAllTests(unsigned long &numberOfTestsDeclared) {
-
-        // Polymorph with adt
-        PriorityQueueKv<int, std::string> priorityQueueKv;
-        auto &                            priorityQueueKvAdt =
-                (PriorityQueueKvAdt<int, std::string> &) priorityQueueKv;
-
+    template<typename Reader, typename RunTest>
+    static void parseAllTests(Reader &      reader,
+                              unsigned long numberOfTestsDeclared,
+                              RunTest &     runTest) {
         /*
          * IMPORTANT: the below loop ends only when the user inputs another
          * whole `\n` line - As said in the "mama" forum at:
          * https://mama.mta.ac.il/mod/forum/discuss.php?d=5015.
+         * The end of the input is treated as such an empty line.
          */
-        unsigned long i = 0;
-        std::string   line;
-        for (; !((line = Input::getLine(std::cin)).empty()); i++) {
+        unsigned long           i = 0;
+        std::string_view        line;
+        CommandDecoder::Command test;
+        for (; !((line = Input::getLine(reader)).empty()); i++) {
             if (i >= numberOfTestsDeclared) {
 
                 /*
@@ -66,8 +445,8 @@ class TestRunner {
                 throw std::runtime_error(Constants::WRONG_INPUT);
             }
 
-            BaseArray<std::string> test = Input::getTest(line, ' ', i);
-            runTest<int, std::string>(test, priorityQueueKvAdt);
+            decodeTest(reader, line, i, test);
+            if (!runTest(test)) { return; }
         }
 
         if (i != numberOfTestsDeclared) {
@@ -82,36 +461,294 @@ class TestRunner {
     }
 
   private:
-    template<typename K, typename V>
-    static void runTest(BaseArray<std::string> &  test,
-                        PriorityQueueKvAdt<K, V> &priorityQueueKvAdt) {
-        invokeMethodInPriorityQueueBySwitchAndPrintReturnValuesIfExist(
-                test, priorityQueueKvAdt);
+    /**
+     * @brief The same as @link parseAllTests @endlink - for the *binary*
+     *        "tests", which are exactly as many as declared.
+     */
+    template<typename ByteReader, typename RunTest>
+    static void parseAllBinaryTests(ByteReader &  reader,
+                                    unsigned long numberOfTestsDeclared,
+                                    RunTest &     runTest) {
+        CommandDecoder::Command test;
+        for (unsigned long i = 0; i < numberOfTestsDeclared; i++) {
+            BinaryProtocol::readCommand(reader, i, test);
+            if (!runTest(test)) { return; }
+        }
+
+        // There must be no more "tests" than declared.
+        char nextByte = 0;
+        if (reader.peekByte(nextByte)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+    }
+
+  private:
+    /**
+     * @return the maximum amount of "tests" in a batch read from the given
+     *         *streamed* @p reader - `1` when it reads a terminal, or the
+     *         @p writer flushes by line, so that an interactive user sees
+     *         the result of each "test" at once. Else, `BATCH_SIZE`.
+     */
+    static unsigned long getMaximumBatchSize(const BufferedReader &reader,
+                                             const OutputWriter &  writer) {
+        bool isInteractive =
+                reader.isTerminal() ||
+                (writer.getFlushPolicy() == OutputWriter::FlushPolicy::LINE);
+        return isInteractive ? 1 : BATCH_SIZE;
     }
 
   private:
-    static void invokeMethodInPriorityQueueBySwitchAndPrintReturnValuesIfExist(
-            BaseArray<std::string> &              test,
-            PriorityQueueKvAdt<int, std::string> &priorityQueueKvAdt) {
-        try {
-            char methodLetterToInvokeInPriorityQueue = test.getElement(0)[0];
-            if (methodLetterToInvokeInPriorityQueue == 'a') {
-                std::cout << priorityQueueKvAdt.max() << std::endl;
-            } else if (methodLetterToInvokeInPriorityQueue == 'b') {
-                std::cout << priorityQueueKvAdt.deleteMax() << std::endl;
-            } else if (methodLetterToInvokeInPriorityQueue == 'c') {
-                std::cout << priorityQueueKvAdt.min() << std::endl;
-            } else if (methodLetterToInvokeInPriorityQueue == 'd') {
-                std::cout << priorityQueueKvAdt.deleteMin() << std::endl;
-            } else if (methodLetterToInvokeInPriorityQueue == 'e') {
-                priorityQueueKvAdt.createEmpty();
-            } else if (methodLetterToInvokeInPriorityQueue == 'f') {
-                priorityQueueKvAdt.insert(stoi(test.getElement(1)),
-                                          test.getElement(2));
-            } else if (methodLetterToInvokeInPriorityQueue == 'g') {
-                std::cout << priorityQueueKvAdt.median() << std::endl;
+    /// A regular file read ahead is never interactive.
+    static unsigned long
+    getMaximumBatchSize(const AsyncFileReader & /* reader */,
+                        const OutputWriter & /* writer */) {
+        return BATCH_SIZE;
+    }
+
+  private:
+    /// A *whole* input that is already in memory is always fully batched.
+    static unsigned long
+    getMaximumBatchSize(const LineReaderAdt & /* reader */,
+                        const OutputWriter & /* writer */) {
+        return BATCH_SIZE;
+    }
+
+  private:
+    /// @return whether the @p reader has more input already read.
+    static bool hasBufferedInput(const BufferedReader &reader) {
+        return reader.hasBufferedInput();
+    }
+
+  private:
+    /// A *whole* input that is already in memory is all buffered.
+    static bool hasBufferedInput(const LineReaderAdt & /* reader */) {
+        return true;
+    }
+
+  private:
+    static void decodeTest(LineReaderAdt & /* reader */, std::string_view line,
+                           unsigned long i, CommandDecoder::Command &test) {
+        CommandDecoder::decode(line, i, test);
+    }
+
+  private:
+    /// Decodes the @p line with the *key-end* already found by the @p reader.
+    static void decodeTest(StructuralLineReader &reader, std::string_view line,
+                           unsigned long i, CommandDecoder::Command &test) {
+        CommandDecoder::decode(line, i, test, reader.getKeyEnd());
+    }
+
+  private:
+    /**
+     * @brief Sets the given @p operation to the operation of the given
+     *        @p test - through a table of the operation types, indexed by the
+     *        letter of the "test".
+     *
+     * @param value the value of an `f` "test".
+     */
+    template<typename Value>
+    static void toOperation(const CommandDecoder::Command &test, Value &&value,
+                            Operation &operation) {
+        static constexpr OperationType OPERATION_TYPES[] = {
+                OperationType::MAX,          // a
+                OperationType::DELETE_MAX,   // b
+                OperationType::MIN,          // c
+                OperationType::DELETE_MIN,   // d
+                OperationType::CREATE_EMPTY, // e
+                OperationType::INSERT,       // f
+                OperationType::MEDIAN        // g
+        };
+
+        operation.type = OPERATION_TYPES[test.opcode -
+                                         CommandDecoder::MINIMUM_LETTER];
+        if (operation.type == OperationType::INSERT) {
+            operation.key = test.key;
+            operation.value.assign((Value &&) value);
+        }
+    }
+
+  private:
+    /// A "test" passed from the parsing thread to the executing thread.
+    struct PipelinedTest {
+
+        /// The "test". Its `value` is *not* set - see `value` below.
+        CommandDecoder::Command test;
+
+        /// The value of the "test" - owned, as its line is not kept.
+        std::string value;
+
+        /// Whether there are no more "tests" after `this` one.
+        bool isLast = false;
+    };
+
+  private:
+    /// A result passed from the executing thread to the writing thread.
+    struct PipelinedResult {
+
+        Entry<int, std::string> result;
+
+        /// Whether there are no more results after `this` one.
+        bool isLast = false;
+    };
+
+  private:
+    /**
+     * @brief Runs all the "tests" that the given @p parseAllTests function
+     *        parses, in a *pipeline* of 3 threads:
+     * @li The calling thread *parses* the "tests", and passes them on.
+     * @li An *executing* thread runs them on the `PriorityQueueKv`, and
+     *     passes their results on.
+     * @li A *writing* thread writes the results, by their order.
+     *
+     * Each two threads pass the "tests" or the results by the order of the
+     * input through a *lock-free* `SpscRing` - so that the output is exactly
+     * the same as the output of running them *serially*.
+     *
+     * In case of a wrong input - whether found while parsing, executing or
+     * writing - the results of all the "tests" before it are still written,
+     * and the exception is rethrown, only after all the threads finished.
+     * The threads before the failed thread stop at once, and the threads
+     * after it finish what was passed to them before the failure.
+     * @param isPinned whether to pin each of the threads to its own CPU.
+     * @see runAllTests
+     */
+    template<typename ParseAllTests>
+    static void runAllTestsPipelined(OutputWriter &writer, bool isBinary,
+                                     bool           isPinned,
+                                     ParseAllTests &parseAllTests) {
+        SpscRing<PipelinedTest>   tests(PIPELINE_RING_CAPACITY);
+        SpscRing<PipelinedResult> results(PIPELINE_RING_CAPACITY);
+
+        // Set once the executing thread finished, or the writing thread failed.
+        std::atomic<bool> isParsingStopped(false);
+        std::atomic<bool> isWritingFailed(false);
+
+        std::exception_ptr executingException;
+        std::thread        executingThread([&] {
+            try {
+                executeAllTests(tests, results, isWritingFailed);
+            } catch (...) { executingException = std::current_exception(); }
+            isParsingStopped = true;
+
+            PipelinedResult last;
+            last.isLast = true;
+            results.push((PipelinedResult &&) last, isWritingFailed);
+        });
+
+        std::exception_ptr writingException;
+        std::thread        writingThread([&] {
+            try {
+                writeAllResults(results, writer, isBinary);
+            } catch (...) {
+                writingException = std::current_exception();
+                isWritingFailed  = true;
+                isParsingStopped = true;
             }
-        } catch (std::exception &e) { throw; }
+        });
+
+        if (isPinned) {
+            BasicAlgorithms::pinThreadToCpu(pthread_self(), 0);
+            BasicAlgorithms::pinThreadToCpu(executingThread.native_handle(), 1);
+            BasicAlgorithms::pinThreadToCpu(writingThread.native_handle(), 2);
+        }
+
+        std::exception_ptr parsingException;
+        try {
+            parseAllTests([&](CommandDecoder::Command &test) {
+                PipelinedTest pipelinedTest;
+                pipelinedTest.test  = test;
+                pipelinedTest.value = test.value;
+                return tests.push((PipelinedTest &&) pipelinedTest,
+                                  isParsingStopped);
+            });
+        } catch (...) { parsingException = std::current_exception(); }
+
+        PipelinedTest last;
+        last.isLast = true;
+        tests.push((PipelinedTest &&) last, isParsingStopped);
+
+        executingThread.join();
+        writingThread.join();
+        for (auto &exception :
+             {writingException, executingException, parsingException}) {
+            if (exception) { std::rethrow_exception(exception); }
+        }
+    }
+
+  private:
+    /**
+     * @brief The executing thread of @link runAllTestsPipelined @endlink.
+     *
+     * @param isWritingFailed once it is `true`, the executing is stopped.
+     */
+    static void executeAllTests(SpscRing<PipelinedTest> &  tests,
+                                SpscRing<PipelinedResult> &results,
+                                const std::atomic<bool> &  isWritingFailed) {
+
+        PriorityQueueKv<int, std::string> priorityQueueKv;
+        std::unique_ptr<Operation[]>      batch(new Operation[BATCH_SIZE]);
+
+        PipelinedTest pipelinedTest;
+        bool          isLast         = false;
+        bool          isResultPushed = true;
+        while (!isLast && isResultPushed &&
+               tests.pop(pipelinedTest, isWritingFailed)) {
+
+            // All the "tests" that are already passed are applied at once.
+            unsigned long batchSize = 0;
+            do {
+                isLast = pipelinedTest.isLast;
+                if (isLast) { break; }
+
+                // The owned value is moved, instead of copied again.
+                toOperation(pipelinedTest.test,
+                            (std::string &&) pipelinedTest.value,
+                            batch[batchSize++]);
+            } while ((batchSize < BATCH_SIZE) && tests.tryPop(pipelinedTest));
+
+            priorityQueueKv.applyBatch(
+                    batch.get(), batchSize, [&](auto &&result) {
+                        if (!isResultPushed) { return; }
+
+                        PipelinedResult pipelinedResult;
+                        pipelinedResult.result = Entry<int, std::string>(
+                                (decltype(result) &&) result);
+                        isResultPushed = results.push(
+                                (PipelinedResult &&) pipelinedResult,
+                                isWritingFailed);
+                    });
+        }
+    }
+
+  private:
+    /// @brief The writing thread of @link runAllTestsPipelined @endlink.
+    static void writeAllResults(SpscRing<PipelinedResult> &results,
+                                OutputWriter &writer, bool isBinary) {
+
+        // The executing thread always passes the last result.
+        const std::atomic<bool> isNeverAborted(false);
+
+        PipelinedResult pipelinedResult;
+        while (results.pop(pipelinedResult, isNeverAborted) &&
+               !pipelinedResult.isLast) {
+            writeResult(writer, pipelinedResult.result, isBinary);
+        }
+    }
+
+  private:
+    /**
+     * @brief Writes the given @p entry as a *binary* result, or as a whole
+     *        line.
+     */
+    template<typename V>
+    static void writeResult(OutputWriter &writer, const Entry<int, V> &entry,
+                            bool isBinary) {
+        if (isBinary) {
+            BinaryProtocol::writeResult(writer, entry);
+            return;
+        }
+        writer.write(entry);
+        writer.endLine();
     }
 };
 
@@ -0,0 +1,78 @@
+
+#ifndef TRACEPOINTS_H
+#define TRACEPOINTS_H
+
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__linux__) && __has_include(<sys/sdt.h>) && \
+        !defined(PRIORITY_QUEUE_KV_NO_TRACEPOINTS)
+#include <sys/sdt.h>
+#if defined(STAP_PROBEV)
+#define TRACEPOINTS_SUPPORTED
+#endif
+#endif
+
+/**
+ * @brief Fires the *static user-space tracepoint* (USDT) @p name of the
+ *        `priority_queue_kv` provider, with up to `12` integer arguments.
+ *
+ * A tracepoint is a single `nop` in the code, plus a note in the ELF that
+ * tells a tracer where it is - so it costs nothing until a tracer - for
+ * example, `bpftrace` or `perf` - attaches to it, on a *live* process,
+ * without rebuilding it. It is defined only when `<sys/sdt.h>` exists - for
+ * example, from the `systemtap-sdt-dev` package - and not
+ * `PRIORITY_QUEUE_KV_NO_TRACEPOINTS`. Else, it does nothing, and its
+ * arguments are not even evaluated.
+ *
+ * The tracepoints:
+ * @li `insert(key, size)` - before `PriorityQueueKv::insert`, with the size
+ *     before it.
+ * @li `delete_min(key, size)` and `delete_max(key, size)` - after
+ *     `PriorityQueueKv::deleteMin` and `PriorityQueueKv::deleteMax`, with
+ *     the key deleted and the new size.
+ * @li `rebalance(isLessToGreater, key, lessSize, greaterSize)` - after an
+ *     element was transferred between the two halves of the
+ *     `PriorityQueueKv`, to keep the median at the root of the "less" half.
+ * @li `sift(depth, size, isUpwards)` - after an element was sifted in a
+ *     `Heap`, with the amount of levels it moved.
+ * @li `node_pool_grow(blockCapacity, capacity)` - after a `NodePool`
+ *     allocated a new block of nodes.
+ *
+ * The keys are passed as `long` - see @link TraceArgument @endlink. The
+ * `sift`s of a delete fire before the delete itself, on the same thread.
+ * So, for example, the sift depth of each `deleteMin`:
+ * @code
+ * bpftrace -p $PID -e '
+ *     usdt:./mivneiNetunimEx2:priority_queue_kv:sift { @d[tid] += arg0; }
+ *     usdt:./mivneiNetunimEx2:priority_queue_kv:delete_min {
+ *         @depth = hist(@d[tid]); @d[tid] = 0; }'
+ * @endcode
+ */
+#ifdef TRACEPOINTS_SUPPORTED
+#define PRIORITY_QUEUE_KV_TRACE(name, ...) \
+    STAP_PROBEV(priority_queue_kv, name, __VA_ARGS__)
+#else
+#define PRIORITY_QUEUE_KV_TRACE(name, ...) \
+    do {                                   \
+    } while (false)
+#endif
+
+/**
+ * @brief Converts a key to an argument of a tracepoint - which must be an
+ *        integer: an arithmetic key is passed by its value, and any other
+ *        key by its address.
+ */
+struct TraceArgument {
+
+    template<typename T>
+    static long of(const T &value) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return (long) value;
+        } else {
+            return (long) (std::uintptr_t) &value;
+        }
+    }
+};
+
+#endif // TRACEPOINTS_H
@@ -2,8 +2,10 @@
 #ifndef UNIQUE_H
 #define UNIQUE_H
 
+#include "BasicAllocations.h"
 #include "Object.h"
 #include <iostream>
+#include <memory>
 
 /**
  * @brief This special class wraps an *any* pointer of an element and
@@ -21,9 +23,12 @@
  *       exception will be thrown, and it will be okay memory-wise without
  *       any leaks.
  * @tparam E the type of element to be stored.
+ * @tparam Allocator a std-allocator compatible allocator, that a "rvalue"
+ *                   element is allocated with.
  * @see Object
  */
-template<typename E> class Unique : public Object {
+template<typename E, typename Allocator = std::allocator<E>>
+class Unique : public Object {
 
   protected:
     E *_element = nullptr;
@@ -31,14 +36,20 @@ template<typename E> class Unique : public Object {
   protected:
     bool _needToDeleteElement = false;
 
+  protected:
+    /// The allocator that a "rvalue" element is allocated with.
+    Allocator _allocator;
+
   public:
     /**
      * @param element a "rvalue" element to be stored.
-     *                An extra allocation is needed.
+     *                An extra allocation is needed, via the @p allocator.
+     * @param allocator the allocator to allocate the element with.
      */
-    explicit Unique(E &&element) {
+    explicit Unique(E &&element, const Allocator &allocator = Allocator())
+        : _allocator(allocator) {
         _needToDeleteElement = true;
-        _element             = new E(element);
+        _element = BasicAllocations::create<E>(_allocator, (E &&) element);
     }
 
   public:
@@ -46,7 +57,8 @@ template<typename E> class Unique : public Object {
      * @param element a "lvalue" element to be stored.
      *                No extra allocation is needed.
      */
-    explicit Unique(E *element) : _element(element) {}
+    explicit Unique(E *element, const Allocator &allocator = Allocator())
+        : _element(element), _allocator(allocator) {}
 
   public:
     Unique(const Unique &unique) = default;
@@ -56,7 +68,9 @@ template<typename E> class Unique : public Object {
 
   protected:
     void deleteThis() {
-        if (_needToDeleteElement) { delete _element; }
+        if (_needToDeleteElement) {
+            BasicAllocations::destroy(_allocator, _element);
+        }
     }
 
   public:
@@ -0,0 +1,413 @@
+#include "Entry.h"
+#include "MinHeap.h"
+#include "PriorityQueueKv.h"
+#include "bench/PerfEventCounters.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Measures the time of each operation of the heaps and of the
+ *        `PriorityQueueKv`, in ns/op - at sizes from `1e3` up to `1e8`, next
+ *        to the standard containers that would replace them.
+ *
+ * Usage:
+ * @code
+ * heapBenchmark [--min-size N] [--max-size N] [--perf] [--json]
+ * @endcode
+ * @li `--min-size` the first size measured. Defaults to `1000`.
+ * @li `--max-size` the last size measured - each size is `10` times the
+ *     size before it. Defaults to `1000000`. A `PriorityQueueKv` of `1e8`
+ *     entries takes about 10 GB.
+ * @li `--perf` counts the hardware performance counters of each operation
+ *     as well - see `PerfEventCounters` - and prints them per operation. A
+ *     counter that is not available is printed as `-`.
+ * @li `--json` prints the results as JSON, instead of as a table.
+ *
+ * Each operation is measured on `size` elements - and repeated, for the
+ * small sizes, until about `1e6` operations were measured in total:
+ * @li `MinHeap<int>` - `insert`, `deleteRoot`, `fixHeap` (of a root whose
+ *     key was replaced) and `buildHeap` (per element), next to a
+ *     `std::priority_queue<int>` - `push` and `pop`.
+ * @li `PriorityQueueKv<int, std::string>` - `insert`, `median`, `deleteMin`
+ *     and `deleteMax`, next to the same operations on two balanced
+ *     `std::multiset`s.
+ *
+ * @note measure an optimized build - for example, configured with
+ *       `-DCMAKE_BUILD_TYPE=Release`.
+ */
+
+namespace {
+
+/// The amount of operations to measure per size, at least.
+constexpr unsigned long MINIMUM_OPERATION_COUNT = 1000000;
+
+/// Whether to count the hardware performance counters - see `--perf`.
+bool isCountingPerfEvents = false;
+
+/// The result of measuring a single operation at a single size.
+struct Result {
+
+    std::string name;
+
+    unsigned long size = 0;
+
+    unsigned long operationCount = 0;
+
+    double nanoseconds = 0;
+
+    /// The value of each counter, in total - or `-1` if not counted.
+    double perfEvents[PerfEventCounters::COUNTER_COUNT] = {-1, -1, -1, -1,
+                                                           -1};
+};
+
+/// Accumulates the time of an operation, over all of its repetitions.
+class Phase {
+
+  protected:
+    std::chrono::steady_clock::time_point _start;
+
+  protected:
+    /// The hardware performance counters - only with `--perf`.
+    std::unique_ptr<PerfEventCounters> _perfEventCounters;
+
+  public:
+    unsigned long operationCount = 0;
+
+  public:
+    double nanoseconds = 0;
+
+  public:
+    Phase() {
+        if (isCountingPerfEvents) {
+            _perfEventCounters = std::make_unique<PerfEventCounters>();
+        }
+    }
+
+  public:
+    void start() {
+        if (_perfEventCounters) { _perfEventCounters->start(); }
+        _start = std::chrono::steady_clock::now();
+    }
+
+  public:
+    void stop(unsigned long operations) {
+        auto end = std::chrono::steady_clock::now();
+        if (_perfEventCounters) { _perfEventCounters->stop(); }
+        nanoseconds += std::chrono::duration<double, std::nano>(end - _start)
+                               .count();
+        operationCount += operations;
+    }
+
+  public:
+    /// @brief Sets the counters of the @p result that were counted.
+    void getPerfEvents(Result &result) const {
+        if (!_perfEventCounters) { return; }
+        for (unsigned long i = 0; i < PerfEventCounters::COUNTER_COUNT; i++) {
+            auto counter = (PerfEventCounters::Counter) i;
+            if (_perfEventCounters->isAvailable(counter)) {
+                result.perfEvents[i] =
+                        (double) _perfEventCounters->getValue(counter);
+            }
+        }
+    }
+};
+
+/// Keeps the results of the operations from being optimized away.
+volatile long sink = 0;
+
+/// @return @p count keys - the same keys for the same @p count.
+std::vector<int> generateKeys(unsigned long count) {
+    std::mt19937     random(20220101);
+    std::vector<int> keys(count);
+    for (int &key : keys) { key = (int) random(); }
+    return keys;
+}
+
+/// @return the amount of times to repeat the operations of @p size elements.
+unsigned long getRepetitions(unsigned long size) {
+    return std::max(1UL, MINIMUM_OPERATION_COUNT / size);
+}
+
+void addResult(std::vector<Result> &results, const std::string &name,
+               unsigned long size, const Phase &phase) {
+    Result result;
+    result.name           = name;
+    result.size           = size;
+    result.operationCount = phase.operationCount;
+    result.nanoseconds    = phase.nanoseconds;
+    phase.getPerfEvents(result);
+    results.push_back(result);
+}
+
+void benchmarkHeap(unsigned long size, std::vector<Result> &results) {
+    std::vector<int> keys = generateKeys(size);
+    std::vector<int> elements(size);
+    Phase            insert, deleteRoot, fixHeap, buildHeap;
+    for (unsigned long r = 0; r < getRepetitions(size); r++) {
+        elements = keys;
+        MinHeap<int> heap(size);
+        insert.start();
+        for (int &element : elements) { heap.insert(&element); }
+        insert.stop(size);
+
+        fixHeap.start();
+        for (unsigned long i = 0; i < size; i++) {
+            *heap.getRoot() = keys[size - 1 - i];
+            heap.fixHeap(0);
+        }
+        fixHeap.stop(size);
+
+        deleteRoot.start();
+        for (unsigned long i = 0; i < size; i++) {
+            sink = sink + *heap.deleteRoot();
+        }
+        deleteRoot.stop(size);
+
+        elements = keys;
+        buildHeap.start();
+        heap.buildHeap(elements.data(), size);
+        buildHeap.stop(size);
+        sink = sink + *heap.getRoot();
+    }
+    addResult(results, "Heap::insert", size, insert);
+    addResult(results, "Heap::deleteRoot", size, deleteRoot);
+    addResult(results, "Heap::fixHeap", size, fixHeap);
+    addResult(results, "Heap::buildHeap", size, buildHeap);
+}
+
+void benchmarkStdPriorityQueue(unsigned long        size,
+                               std::vector<Result> &results) {
+    std::vector<int> keys = generateKeys(size);
+    Phase            push, pop;
+    for (unsigned long r = 0; r < getRepetitions(size); r++) {
+        std::priority_queue<int, std::vector<int>, std::greater<int>> queue;
+        push.start();
+        for (int key : keys) { queue.push(key); }
+        push.stop(size);
+
+        pop.start();
+        for (unsigned long i = 0; i < size; i++) {
+            sink = sink + queue.top();
+            queue.pop();
+        }
+        pop.stop(size);
+    }
+    addResult(results, "std::priority_queue::push", size, push);
+    addResult(results, "std::priority_queue::pop", size, pop);
+}
+
+/**
+ * @brief The baseline of the `PriorityQueueKv` - a median kept between two
+ *        balanced `std::multiset`s, so that the median is the maximum of the
+ *        lower one, the same way.
+ */
+class MultisetMedianQueue {
+    typedef Entry<int, std::string> E;
+
+  protected:
+    /// The `ceil(n / 2)` lowest entries.
+    std::multiset<E> _lower;
+
+  protected:
+    std::multiset<E> _upper;
+
+  public:
+    void insert(int key, std::string value) {
+        E element(key, (std::string &&) value);
+        if (_lower.empty() || !(*_lower.rbegin() < element)) {
+            _lower.insert((E &&) element);
+        } else {
+            _upper.insert((E &&) element);
+        }
+        balance();
+    }
+
+  public:
+    E median() const { return *_lower.rbegin(); }
+
+  public:
+    E deleteMin() {
+        E element = *_lower.begin();
+        _lower.erase(_lower.begin());
+        balance();
+        return element;
+    }
+
+  public:
+    E deleteMax() {
+        std::multiset<E> &half    = _upper.empty() ? _lower : _upper;
+        auto              last    = std::prev(half.end());
+        E                 element = *last;
+        half.erase(last);
+        balance();
+        return element;
+    }
+
+  protected:
+    void balance() {
+        if (_lower.size() > _upper.size() + 1) {
+            auto last = std::prev(_lower.end());
+            _upper.insert(*last);
+            _lower.erase(last);
+        } else if (_upper.size() > _lower.size()) {
+            _lower.insert(*_upper.begin());
+            _upper.erase(_upper.begin());
+        }
+    }
+};
+
+/**
+ * @brief Measures `insert` of @p size entries, `median` @p size times, and
+ *        then `deleteMin` and `deleteMax` of half of them each.
+ */
+template<typename Queue>
+void benchmarkMedianQueue(const std::string &name, unsigned long size,
+                          std::vector<Result> &           results,
+                          const std::function<Queue *()> &createQueue) {
+    std::vector<int> keys = generateKeys(size);
+    std::string      value("value");
+    Phase            insert, median, deleteMin, deleteMax;
+    for (unsigned long r = 0; r < getRepetitions(size); r++) {
+        std::unique_ptr<Queue> queue(createQueue());
+        insert.start();
+        for (int key : keys) { queue->insert(key, value); }
+        insert.stop(size);
+
+        median.start();
+        for (unsigned long i = 0; i < size; i++) {
+            sink = sink + queue->median().getKey();
+        }
+        median.stop(size);
+
+        deleteMin.start();
+        for (unsigned long i = 0; i < size / 2; i++) {
+            sink = sink + queue->deleteMin().getKey();
+        }
+        deleteMin.stop(size / 2);
+
+        deleteMax.start();
+        for (unsigned long i = size / 2; i < size; i++) {
+            sink = sink + queue->deleteMax().getKey();
+        }
+        deleteMax.stop(size - size / 2);
+    }
+    addResult(results, name + "::insert", size, insert);
+    addResult(results, name + "::median", size, median);
+    addResult(results, name + "::deleteMin", size, deleteMin);
+    addResult(results, name + "::deleteMax", size, deleteMax);
+}
+
+void printTable(const std::vector<Result> &results) {
+    std::printf("%-36s %12s %14s %12s", "operation", "size", "operations",
+                "ns/op");
+    if (isCountingPerfEvents) {
+        for (const char *name : PerfEventCounters::NAMES) {
+            std::printf(" %14s", name);
+        }
+    }
+    std::printf("\n");
+    for (const Result &result : results) {
+        std::printf("%-36s %12lu %14lu %12.1f", result.name.c_str(),
+                    result.size, result.operationCount,
+                    result.nanoseconds / (double) result.operationCount);
+        for (unsigned long i = 0;
+             isCountingPerfEvents && (i < PerfEventCounters::COUNTER_COUNT);
+             i++) {
+            if (result.perfEvents[i] < 0) {
+                std::printf(" %14s", "-");
+            } else {
+                std::printf(" %14.2f", result.perfEvents[i] /
+                                               (double) result.operationCount);
+            }
+        }
+        std::printf("\n");
+    }
+}
+
+void printJson(const std::vector<Result> &results) {
+    std::printf("{\n  \"benchmarks\": [");
+    for (unsigned long i = 0; i < results.size(); i++) {
+        const Result &result = results[i];
+        std::printf("%s\n    {\"name\": \"%s\", \"size\": %lu, "
+                    "\"operations\": %lu, \"nsPerOp\": %.3f",
+                    (i == 0) ? "" : ",", result.name.c_str(), result.size,
+                    result.operationCount,
+                    result.nanoseconds / (double) result.operationCount);
+        for (unsigned long j = 0; j < PerfEventCounters::COUNTER_COUNT; j++) {
+            if (result.perfEvents[j] >= 0) {
+                std::printf(", \"%sPerOp\": %.3f", PerfEventCounters::NAMES[j],
+                            result.perfEvents[j] /
+                                    (double) result.operationCount);
+            }
+        }
+        std::printf("}");
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long minimumSize = 1000;
+    unsigned long maximumSize = 1000000;
+    bool          isJson      = false;
+    try {
+        for (int i = 1; i < argc; i++) {
+            if ((std::strcmp(argv[i], "--min-size") == 0) && (i + 1 < argc)) {
+                minimumSize = (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--max-size") == 0) &&
+                       (i + 1 < argc)) {
+                maximumSize = (unsigned long) std::stod(argv[++i]);
+            } else if (std::strcmp(argv[i], "--perf") == 0) {
+                isCountingPerfEvents = true;
+            } else if (std::strcmp(argv[i], "--json") == 0) {
+                isJson = true;
+            } else {
+                throw std::invalid_argument(argv[i]);
+            }
+        }
+        if (minimumSize < 1) { throw std::invalid_argument("--min-size"); }
+    } catch (std::exception &e) {
+        std::cerr << "Usage: heapBenchmark [--min-size N] [--max-size N] "
+                     "[--perf] [--json]"
+                  << std::endl;
+        return 1;
+    }
+
+    if (isCountingPerfEvents && !PerfEventCounters().isAnyAvailable()) {
+        std::cerr << "heapBenchmark: no performance counter is available."
+                  << std::endl;
+    }
+
+    std::vector<Result> results;
+    for (unsigned long size = minimumSize; size <= maximumSize; size *= 10) {
+        benchmarkHeap(size, results);
+        benchmarkStdPriorityQueue(size, results);
+        benchmarkMedianQueue<PriorityQueueKv<int, std::string>>(
+                "PriorityQueueKv", size, results, [size] {
+                    return new PriorityQueueKv<int, std::string>((int) size);
+                });
+        benchmarkMedianQueue<MultisetMedianQueue>(
+                "std::multiset median", size, results,
+                [] { return new MultisetMedianQueue(); });
+        if (!isJson) { std::fprintf(stderr, "size %lu done\n", size); }
+    }
+
+    if (isJson) {
+        printJson(results);
+    } else {
+        printTable(results);
+    }
+    return 0;
+}
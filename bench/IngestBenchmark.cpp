@@ -0,0 +1,395 @@
+#include "CommandDecoder.h"
+#include "MappedFile.h"
+#include "OutputWriter.h"
+#include "PriorityQueueKv.h"
+#include "StructuralLineReader.h"
+#include "TestRunner.h"
+#include "bench/PerfEventCounters.h"
+#include "tools/WorkloadGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Measures the throughput of the *whole* program - reading, decoding
+ *        and executing the commands of a file, and writing their results to
+ *        a null sink - in commands/s and in MB/s, with the time of each of
+ *        these stages.
+ *
+ * Usage:
+ * @code
+ * ingestBenchmark [--min-commands N] [--max-commands N] [--file path]
+ *                 [--pipeline] [--parallel-parse] [--async-read] [--perf]
+ *                 [--json]
+ * @endcode
+ * @li `--min-commands` the amount of commands of the first file generated.
+ *     Defaults to `1e6`.
+ * @li `--max-commands` the amount of commands of the last file generated -
+ *     each file has `10` times the commands of the file before it. Defaults
+ *     to `--min-commands`. A file of `1e9` commands takes about 7 GB.
+ * @li `--file` the path of the files generated. Defaults to a file in
+ *     `/tmp`. The file is deleted afterwards.
+ * @li `--pipeline`, `--parallel-parse` and `--async-read` run the program
+ *     with these options of `main`.
+ * @li `--perf` counts the hardware performance counters of each stage as
+ *     well - see `PerfEventCounters` - per command. Only the main thread is
+ *     counted, so the threads of `--pipeline` and of `--parallel-parse` are
+ *     not.
+ *
+ * The files are generated by the `WorkloadGenerator`, with its default
+ * options. Each file is first read once, so that all of the stages below
+ * read it from the page cache. Each stage does the work of the stage before
+ * it, and more - so the time of a stage is the difference between its time
+ * and the time of the stage before it:
+ * @li `read` - reads the lines of the file through a `StructuralLineReader`.
+ * @li `decode` - decodes each line through the `CommandDecoder`.
+ * @li `execute` - applies the commands to a `PriorityQueueKv`, in batches,
+ *     and only sums the keys of their results.
+ * @li `output` - runs the program itself, through `TestRunner`, with its
+ *     standard output redirected to `/dev/null` - so this is the time of
+ *     writing the results, plus the program's own overhead.
+ *
+ * @note measure an optimized build - for example, configured with
+ *       `-DCMAKE_BUILD_TYPE=Release`.
+ */
+
+namespace {
+
+typedef PriorityQueueKv<int, std::string> Queue;
+
+/// The names of the stages - in order.
+const char *const STAGE_NAMES[] = {"read", "decode", "execute", "output"};
+
+constexpr unsigned long STAGE_COUNT = 4;
+
+/// The result of running all the stages on a single file.
+struct Result {
+
+    unsigned long commandCount = 0;
+
+    unsigned long fileSize = 0;
+
+    /// The *cumulative* time of each stage, in seconds.
+    double seconds[STAGE_COUNT] = {};
+
+    /// The *cumulative* value of each counter of each stage - `-1` if not
+    /// counted.
+    double perfEvents[STAGE_COUNT][PerfEventCounters::COUNTER_COUNT] = {};
+};
+
+/// Whether to count the hardware performance counters - see `--perf`.
+bool isCountingPerfEvents = false;
+
+/// Keeps the results of the stages from being optimized away.
+volatile long sink = 0;
+
+/**
+ * @brief Sets the time that the given @p function takes, in seconds - and
+ *        its counters, with `--perf` - as the given @p stage of the
+ *        @p result.
+ */
+void measure(Result &result, unsigned long stage,
+             const std::function<void()> &function) {
+    std::unique_ptr<PerfEventCounters> counters;
+    if (isCountingPerfEvents) {
+        counters = std::make_unique<PerfEventCounters>();
+        counters->start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    result.seconds[stage] = std::chrono::duration<double>(end - start).count();
+
+    for (unsigned long i = 0; i < PerfEventCounters::COUNTER_COUNT; i++) {
+        result.perfEvents[stage][i] = -1;
+    }
+    if (!counters) { return; }
+    counters->stop();
+    for (unsigned long i = 0; i < PerfEventCounters::COUNTER_COUNT; i++) {
+        auto counter = (PerfEventCounters::Counter) i;
+        if (counters->isAvailable(counter)) {
+            result.perfEvents[stage][i] = (double) counters->getValue(counter);
+        }
+    }
+}
+
+/// Writes a file of @p commandCount commands to @p path.
+void generateCommandFile(const std::string &path, unsigned long commandCount) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { throw std::runtime_error(path); }
+    {
+        WorkloadGenerator::Options options;
+        options.commandCount = commandCount;
+        OutputWriter writer(fd);
+        WorkloadGenerator(options).generate(writer);
+        writer.flush();
+    }
+    ::close(fd);
+}
+
+void readLines(const std::string &path) {
+    MappedFile           file(path);
+    StructuralLineReader reader(file.getView());
+    std::string_view     line;
+    unsigned long        lineCount = 0;
+    while (reader.getLine(line)) { lineCount++; }
+    sink = sink + (long) lineCount;
+}
+
+void decodeLines(const std::string &path) {
+    MappedFile              file(path);
+    StructuralLineReader    reader(file.getView());
+    std::string_view        line;
+    CommandDecoder::Command command;
+    reader.getLine(line);
+    for (unsigned long i = 0; reader.getLine(line); i++) {
+        CommandDecoder::decode(line, i, command, reader.getKeyEnd());
+        sink = sink + command.key;
+    }
+}
+
+void executeCommands(const std::string &path) {
+    static constexpr Queue::OperationType OPERATION_TYPES[] = {
+            Queue::OperationType::MAX,          // a
+            Queue::OperationType::DELETE_MAX,   // b
+            Queue::OperationType::MIN,          // c
+            Queue::OperationType::DELETE_MIN,   // d
+            Queue::OperationType::CREATE_EMPTY, // e
+            Queue::OperationType::INSERT,       // f
+            Queue::OperationType::MEDIAN        // g
+    };
+
+    MappedFile                          file(path);
+    StructuralLineReader                reader(file.getView());
+    std::string_view                    line;
+    CommandDecoder::Command             command;
+    Queue                               queue;
+    std::unique_ptr<Queue::Operation[]> batch(
+            new Queue::Operation[TestRunner::BATCH_SIZE]);
+    unsigned long batchSize = 0;
+    long          keySum    = 0;
+    auto          applyBatch = [&] {
+        queue.applyBatch(batch.get(), batchSize, [&](const auto &result) {
+            keySum += result.getKeyReference();
+        });
+        batchSize = 0;
+    };
+
+    reader.getLine(line);
+    for (unsigned long i = 0; reader.getLine(line); i++) {
+        CommandDecoder::decode(line, i, command, reader.getKeyEnd());
+        Queue::Operation &operation = batch[batchSize++];
+        operation.type = OPERATION_TYPES[command.opcode -
+                                         CommandDecoder::MINIMUM_LETTER];
+        if (operation.type == Queue::OperationType::INSERT) {
+            operation.key = command.key;
+            operation.value.assign(command.value);
+        }
+        if (batchSize == TestRunner::BATCH_SIZE) { applyBatch(); }
+    }
+    applyBatch();
+    sink = sink + keySum;
+}
+
+/// Runs the program on the file in @p path, writing to `/dev/null`.
+void runProgram(const std::string &path, const TestRunner::Options &options) {
+    std::fflush(stdout);
+    int standardOutput = ::dup(STDOUT_FILENO);
+    int null           = ::open("/dev/null", O_WRONLY);
+    ::dup2(null, STDOUT_FILENO);
+    ::close(null);
+    try {
+        TestRunner::getTestArrayAndRunAllTestsFromFile(path, options);
+    } catch (std::exception &e) {
+        ::dup2(standardOutput, STDOUT_FILENO);
+        ::close(standardOutput);
+        throw;
+    }
+    ::dup2(standardOutput, STDOUT_FILENO);
+    ::close(standardOutput);
+}
+
+Result benchmark(const std::string &path, unsigned long commandCount,
+                 const TestRunner::Options &options) {
+    generateCommandFile(path, commandCount);
+    struct stat status {};
+    ::stat(path.c_str(), &status);
+
+    Result result;
+    result.commandCount = commandCount;
+    result.fileSize     = (unsigned long) status.st_size;
+    readLines(path);
+    measure(result, 0, [&] { readLines(path); });
+    measure(result, 1, [&] { decodeLines(path); });
+    measure(result, 2, [&] { executeCommands(path); });
+    measure(result, 3, [&] { runProgram(path, options); });
+    return result;
+}
+
+/// @return the time of the given stage alone, in seconds.
+double getStageSeconds(const Result &result, unsigned long stage) {
+    double seconds = result.seconds[stage];
+    if (stage > 0) { seconds -= result.seconds[stage - 1]; }
+    return std::max(0.0, seconds);
+}
+
+/**
+ * @return the value of the given @p counter of the given stage alone, per
+ *         command - or `-1` if it was not counted.
+ */
+double getStagePerfEvent(const Result &result, unsigned long stage,
+                         unsigned long counter) {
+    double value = result.perfEvents[stage][counter];
+    if (value < 0) { return -1; }
+    if (stage > 0) { value -= result.perfEvents[stage - 1][counter]; }
+    return std::max(0.0, value) / (double) result.commandCount;
+}
+
+void printTable(const std::vector<Result> &results) {
+    for (const Result &result : results) {
+        double total = result.seconds[STAGE_COUNT - 1];
+        std::printf("%lu commands, %.1f MB: %.3f s, %.0f commands/s, "
+                    "%.1f MB/s\n",
+                    result.commandCount, (double) result.fileSize / (1 << 20),
+                    total, (double) result.commandCount / total,
+                    (double) result.fileSize / (1 << 20) / total);
+        if (isCountingPerfEvents) {
+            std::printf("  %-10s %12s %7s", "", "", "");
+            for (const char *name : PerfEventCounters::NAMES) {
+                std::printf(" %14s", name);
+            }
+            std::printf("\n");
+        }
+        for (unsigned long stage = 0; stage < STAGE_COUNT; stage++) {
+            double seconds = getStageSeconds(result, stage);
+            std::printf("  %-10s %10.3f s %6.1f%%", STAGE_NAMES[stage],
+                        seconds, 100 * seconds / total);
+            for (unsigned long i = 0;
+                 isCountingPerfEvents && (i < PerfEventCounters::COUNTER_COUNT);
+                 i++) {
+                double value = getStagePerfEvent(result, stage, i);
+                if (value < 0) {
+                    std::printf(" %14s", "-");
+                } else {
+                    std::printf(" %14.2f", value);
+                }
+            }
+            std::printf("\n");
+        }
+    }
+}
+
+void printJson(const std::vector<Result> &results) {
+    std::printf("{\n  \"benchmarks\": [");
+    for (unsigned long i = 0; i < results.size(); i++) {
+        const Result &result = results[i];
+        double        total  = result.seconds[STAGE_COUNT - 1];
+        std::printf("%s\n    {\"commands\": %lu, \"bytes\": %lu, "
+                    "\"seconds\": %.6f, \"commandsPerSecond\": %.1f, "
+                    "\"bytesPerSecond\": %.1f, \"stages\": {",
+                    (i == 0) ? "" : ",", result.commandCount, result.fileSize,
+                    total, (double) result.commandCount / total,
+                    (double) result.fileSize / total);
+        for (unsigned long stage = 0; stage < STAGE_COUNT; stage++) {
+            std::printf("%s\"%s\": %.6f", (stage == 0) ? "" : ", ",
+                        STAGE_NAMES[stage], getStageSeconds(result, stage));
+        }
+        std::printf("}");
+        for (unsigned long i = 0; i < PerfEventCounters::COUNTER_COUNT; i++) {
+            if (result.perfEvents[0][i] < 0) { continue; }
+            std::printf(", \"%sPerCommand\": {", PerfEventCounters::NAMES[i]);
+            for (unsigned long stage = 0; stage < STAGE_COUNT; stage++) {
+                std::printf("%s\"%s\": %.3f", (stage == 0) ? "" : ", ",
+                            STAGE_NAMES[stage],
+                            getStagePerfEvent(result, stage, i));
+            }
+            std::printf("}");
+        }
+        std::printf("}");
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long       minimumCommandCount = 1000000;
+    unsigned long       maximumCommandCount = 0;
+    std::string         path = "/tmp/ingestBenchmark.commands.txt";
+    bool                isJson = false;
+    TestRunner::Options options;
+    try {
+        for (int i = 1; i < argc; i++) {
+            if ((std::strcmp(argv[i], "--min-commands") == 0) &&
+                (i + 1 < argc)) {
+                minimumCommandCount = (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--max-commands") == 0) &&
+                       (i + 1 < argc)) {
+                maximumCommandCount = (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--file") == 0) &&
+                       (i + 1 < argc)) {
+                path = argv[++i];
+            } else if (std::strcmp(argv[i], "--pipeline") == 0) {
+                options.isPipelined = true;
+            } else if (std::strcmp(argv[i], "--parallel-parse") == 0) {
+                options.isParsedInParallel = true;
+            } else if (std::strcmp(argv[i], "--async-read") == 0) {
+                options.isReadAsynchronously = true;
+            } else if (std::strcmp(argv[i], "--perf") == 0) {
+                isCountingPerfEvents = true;
+            } else if (std::strcmp(argv[i], "--json") == 0) {
+                isJson = true;
+            } else {
+                throw std::invalid_argument(argv[i]);
+            }
+        }
+        if (minimumCommandCount < 1) {
+            throw std::invalid_argument("--min-commands");
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Usage: ingestBenchmark [--min-commands N] "
+                     "[--max-commands N] [--file path]\n"
+                     "    [--pipeline] [--parallel-parse] [--async-read] "
+                     "[--perf] [--json]"
+                  << std::endl;
+        return 1;
+    }
+    maximumCommandCount = std::max(maximumCommandCount, minimumCommandCount);
+
+    if (isCountingPerfEvents && !PerfEventCounters().isAnyAvailable()) {
+        std::cerr << "ingestBenchmark: no performance counter is available."
+                  << std::endl;
+    }
+
+    std::vector<Result> results;
+    try {
+        for (unsigned long commandCount = minimumCommandCount;
+             commandCount <= maximumCommandCount; commandCount *= 10) {
+            results.push_back(benchmark(path, commandCount, options));
+            if (!isJson) {
+                std::fprintf(stderr, "%lu commands done\n", commandCount);
+            }
+        }
+    } catch (std::exception &e) {
+        std::remove(path.c_str());
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::remove(path.c_str());
+
+    if (isJson) {
+        printJson(results);
+    } else {
+        printTable(results);
+    }
+    return 0;
+}
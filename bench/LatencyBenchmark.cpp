@@ -0,0 +1,256 @@
+#include "CommandDecoder.h"
+#include "LatencyHistogram.h"
+#include "PriorityQueueKv.h"
+#include "tools/WorkloadGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Drives a `PriorityQueueKv` *open-loop* - invoking its methods at a
+ *        fixed rate, no matter how long each of them takes - and prints the
+ *        percentiles of the latency of each method, in ns.
+ *
+ * Usage:
+ * @code
+ * latencyBenchmark [--rate R] [--duration S] [--warmup N] [--max-live N]
+ *                  [--keys uniform | zipf | sorted | reverse | sawtooth |
+ *                          duplicates | adversarial] [--seed S] [--json]
+ * @endcode
+ * @li `--rate` the amount of methods invoked per second. Defaults to
+ *     `200000`.
+ * @li `--duration` the amount of seconds to measure. Defaults to `5`.
+ * @li `--warmup` the amount of methods invoked, as fast as possible, before
+ *     measuring - so that the `PriorityQueueKv` is already full. Defaults to
+ *     `1000000`.
+ * @li `--max-live` the maximum amount of entries at once. Defaults to
+ *     `100000`.
+ * @li `--keys` the distribution of the keys - see `WorkloadGenerator`.
+ *
+ * The methods are the commands of the `WorkloadGenerator`, with its default
+ * mix. The `i`th method is *scheduled* to `i / rate` seconds after the
+ * start - so a slow method delays the methods after it, the same way it
+ * would delay requests that arrive at that rate. Two latencies are measured
+ * for each method:
+ * @li `latency` - from its *scheduled* time to its end. This corrects the
+ *     *coordinated omission* of measuring only from its actual start - a
+ *     stall is counted for every method that was scheduled during it.
+ * @li `service` - from its actual start to its end.
+ *
+ * @note measure an optimized build - for example, configured with
+ *       `-DCMAKE_BUILD_TYPE=Release`. In case the rate is higher than the
+ *       rate the `PriorityQueueKv` can sustain, the `latency` grows without
+ *       a bound - the achieved rate is printed as well.
+ */
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// The names of the methods - indexed by their letter, from `a`.
+const char *const METHOD_NAMES[] = {"max", "deleteMax", "min", "deleteMin",
+                                    "createEmpty", "insert", "median"};
+
+constexpr unsigned long METHOD_COUNT = 7;
+
+const double PERCENTILES[] = {50, 90, 99, 99.9, 99.99};
+
+/// The latencies of a single method.
+struct Latencies {
+
+    LatencyHistogram latency;
+
+    LatencyHistogram service;
+};
+
+/// Keeps the results of the methods from being optimized away.
+volatile long sink = 0;
+
+unsigned long toNanoseconds(Clock::duration duration) {
+    return (unsigned long) std::chrono::nanoseconds(duration).count();
+}
+
+/// Invokes the method of the given @p command on the given @p queue.
+void invoke(PriorityQueueKv<int, std::string> &queue,
+            const CommandDecoder::Command &    command) {
+    switch (command.opcode) {
+        case 'a':
+            sink = sink + queue.max().getKey();
+            break;
+        case 'b':
+            sink = sink + queue.deleteMax().getKey();
+            break;
+        case 'c':
+            sink = sink + queue.min().getKey();
+            break;
+        case 'd':
+            sink = sink + queue.deleteMin().getKey();
+            break;
+        case 'f':
+            queue.insert(command.key, std::string(command.value));
+            break;
+        case 'g':
+            sink = sink + queue.median().getKey();
+            break;
+        default:
+            queue.createEmpty();
+            break;
+    }
+}
+
+void printTable(const Latencies *latencies, const Latencies &all) {
+    std::printf("%-12s %-8s %10s %10s", "method", "", "count", "mean");
+    for (double percentile : PERCENTILES) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "p%g", percentile);
+        std::printf(" %10s", name);
+    }
+    std::printf(" %10s\n", "max");
+
+    for (unsigned long i = 0; i <= METHOD_COUNT; i++) {
+        const Latencies &method = (i < METHOD_COUNT) ? latencies[i] : all;
+        if (method.latency.getCount() == 0) { continue; }
+        const char *name = (i < METHOD_COUNT) ? METHOD_NAMES[i] : "all";
+        for (const LatencyHistogram *histogram :
+             {&method.latency, &method.service}) {
+            std::printf("%-12s %-8s %10lu %10.0f", name,
+                        (histogram == &method.latency) ? "latency"
+                                                       : "service",
+                        histogram->getCount(), histogram->getMean());
+            for (double percentile : PERCENTILES) {
+                std::printf(" %10lu",
+                            histogram->getValueAtPercentile(percentile));
+            }
+            std::printf(" %10lu\n", histogram->getMaximum());
+        }
+    }
+}
+
+void printHistogramJson(const char *name, const LatencyHistogram &histogram) {
+    std::printf("\"%s\": {\"count\": %lu, \"mean\": %.1f", name,
+                histogram.getCount(), histogram.getMean());
+    for (double percentile : PERCENTILES) {
+        std::printf(", \"p%g\": %lu", percentile,
+                    histogram.getValueAtPercentile(percentile));
+    }
+    std::printf(", \"max\": %lu}", histogram.getMaximum());
+}
+
+void printJson(const Latencies *latencies, const Latencies &all,
+               double targetRate, double achievedRate) {
+    std::printf("{\n  \"targetRate\": %.1f,\n  \"achievedRate\": %.1f,\n"
+                "  \"methods\": [",
+                targetRate, achievedRate);
+    bool isFirst = true;
+    for (unsigned long i = 0; i <= METHOD_COUNT; i++) {
+        const Latencies &method = (i < METHOD_COUNT) ? latencies[i] : all;
+        if (method.latency.getCount() == 0) { continue; }
+        std::printf("%s\n    {\"name\": \"%s\", ", isFirst ? "" : ",",
+                    (i < METHOD_COUNT) ? METHOD_NAMES[i] : "all");
+        printHistogramJson("latency", method.latency);
+        std::printf(", ");
+        printHistogramJson("service", method.service);
+        std::printf("}");
+        isFirst = false;
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    double                     rate     = 200000;
+    double                     duration = 5;
+    unsigned long              warmup   = 1000000;
+    bool                       isJson   = false;
+    WorkloadGenerator::Options options;
+    options.maximumLiveCount = 100000;
+    try {
+        for (int i = 1; i < argc; i++) {
+            if ((std::strcmp(argv[i], "--rate") == 0) && (i + 1 < argc)) {
+                rate = std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--duration") == 0) &&
+                       (i + 1 < argc)) {
+                duration = std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--warmup") == 0) &&
+                       (i + 1 < argc)) {
+                warmup = (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--max-live") == 0) &&
+                       (i + 1 < argc)) {
+                options.maximumLiveCount =
+                        (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--keys") == 0) &&
+                       (i + 1 < argc)) {
+                options.keyDistribution =
+                        WorkloadGenerator::getKeyDistribution(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--seed") == 0) &&
+                       (i + 1 < argc)) {
+                options.seed = std::stoul(argv[++i]);
+            } else if (std::strcmp(argv[i], "--json") == 0) {
+                isJson = true;
+            } else {
+                throw std::invalid_argument(argv[i]);
+            }
+        }
+        if (!(rate > 0) || !(duration > 0) ||
+            (options.maximumLiveCount < 1)) {
+            throw std::invalid_argument("--rate");
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Usage: latencyBenchmark [--rate R] [--duration S] "
+                     "[--warmup N] [--max-live N]\n"
+                     "    [--keys uniform | zipf | sorted | reverse | "
+                     "sawtooth | duplicates | adversarial]\n"
+                     "    [--seed S] [--json]"
+                  << std::endl;
+        return 1;
+    }
+
+    WorkloadGenerator                 generator(options);
+    PriorityQueueKv<int, std::string> queue((int) options.maximumLiveCount);
+    CommandDecoder::Command           command;
+    for (unsigned long i = 0; i < warmup; i++) {
+        generator.nextCommand(command);
+        invoke(queue, command);
+    }
+
+    Latencies         latencies[METHOD_COUNT];
+    Latencies         all;
+    auto              count    = (unsigned long) (rate * duration);
+    double            interval = 1e9 / rate;
+    Clock::time_point start    = Clock::now();
+    Clock::time_point now      = start;
+    for (unsigned long i = 0; i < count; i++) {
+        generator.nextCommand(command);
+        Clock::time_point scheduled =
+                start + std::chrono::nanoseconds((long) (i * interval));
+        while (now < scheduled) { now = Clock::now(); }
+
+        Clock::time_point begin = now;
+        invoke(queue, command);
+        now = Clock::now();
+
+        Latencies &method =
+                latencies[command.opcode - CommandDecoder::MINIMUM_LETTER];
+        method.latency.record(toNanoseconds(now - scheduled));
+        method.service.record(toNanoseconds(now - begin));
+    }
+    double seconds      = std::chrono::duration<double>(now - start).count();
+    double achievedRate = (double) count / seconds;
+
+    for (const Latencies &method : latencies) {
+        all.latency.add(method.latency);
+        all.service.add(method.service);
+    }
+    if (isJson) {
+        printJson(latencies, all, rate, achievedRate);
+    } else {
+        std::printf("target rate %.0f/s, achieved rate %.0f/s, latencies "
+                    "in ns\n",
+                    rate, achievedRate);
+        printTable(latencies, all);
+    }
+    return 0;
+}
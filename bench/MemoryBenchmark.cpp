@@ -0,0 +1,184 @@
+#include "MemoryUsage.h"
+#include "PriorityQueueKv.h"
+#include "bench/ProcessMemory.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Measures the memory that a `PriorityQueueKv<int, std::string>`
+ *        holds, in bytes per entry - at sizes from `1e3` up to `1e6` - as
+ *        reported by `PriorityQueueKv::memoryUsage`, broken down by what the
+ *        bytes hold.
+ *
+ * Usage:
+ * @code
+ * memoryBenchmark [--min-size N] [--max-size N] [--value-length N]
+ *                 [--physical-size-factor F] [--json]
+ * @endcode
+ * @li `--min-size` the first size measured. Defaults to `1000`.
+ * @li `--max-size` the last size measured - each size is `10` times the
+ *     size before it. Defaults to `1000000`.
+ * @li `--value-length` the length of each value. Defaults to `8` - within
+ *     the small-string buffer of a `std::string`, so that the values
+ *     allocate nothing by themselves.
+ * @li `--physical-size-factor` the *physical-size* of each heap, as a
+ *     factor of the size - the heaps do not grow, so each of them must have
+ *     room for at least half of the entries. Defaults to `1`.
+ *
+ * The entries are inserted with uniformly random keys. Next to the bytes
+ * reported, the bytes that `malloc` handed out while creating and filling
+ * the `PriorityQueueKv` are printed as well, as a check - see
+ * `ProcessMemory`. These include the overhead of `malloc` itself, which
+ * `memoryUsage` does not count.
+ */
+
+namespace {
+
+/// The parts of the `MemoryUsage` - the name and the bytes of each.
+struct Part {
+
+    const char *name;
+
+    unsigned long MemoryUsage::*bytes;
+};
+
+const Part PARTS[] = {{"arrays", &MemoryUsage::heapArrayBytes},
+                      {"slack", &MemoryUsage::heapArraySlackBytes},
+                      {"wrappers", &MemoryUsage::wrapperBytes},
+                      {"uniques", &MemoryUsage::uniqueBytes},
+                      {"entries", &MemoryUsage::entryBytes},
+                      {"keysValues", &MemoryUsage::keyAndValueBytes},
+                      {"other", &MemoryUsage::otherBytes}};
+
+/// The result of measuring a single size.
+struct Result {
+
+    unsigned long size = 0;
+
+    PriorityQueueKvMemoryUsage memoryUsage;
+
+    /// The bytes handed out by `malloc` - or `0` without `mallinfo2`.
+    unsigned long mallocBytes = 0;
+};
+
+Result measure(unsigned long size, unsigned long valueLength,
+               double physicalSizeFactor) {
+    std::mt19937_64 random(size);
+    Result          result;
+    result.size = size;
+
+    unsigned long mallocBytesBefore =
+            ProcessMemory::sample().mallocInUseBytes;
+    {
+        auto physicalSize = (int) ((double) size * physicalSizeFactor) + 1;
+        PriorityQueueKv<int, std::string> queue(physicalSize);
+        for (unsigned long i = 0; i < size; i++) {
+            queue.insert((int) random(), std::string(valueLength, 'v'));
+        }
+        result.mallocBytes =
+                ProcessMemory::sample().mallocInUseBytes - mallocBytesBefore;
+        result.memoryUsage = queue.memoryUsage();
+    }
+    return result;
+}
+
+double perEntry(unsigned long bytes, const Result &result) {
+    return (double) bytes / (double) result.size;
+}
+
+void printTable(const std::vector<Result> &results) {
+    std::printf("%-10s %14s %11s", "size", "bytes", "bytes/entry");
+    for (const Part &part : PARTS) { std::printf(" %10s", part.name); }
+    std::printf(" %10s %10s %10s\n", "less", "greater", "malloc");
+    for (const Result &result : results) {
+        MemoryUsage total = result.memoryUsage.getTotal();
+        std::printf("%-10lu %14lu %11.1f", result.size, total.getTotal(),
+                    perEntry(total.getTotal(), result));
+        for (const Part &part : PARTS) {
+            std::printf(" %10.1f", perEntry(total.*part.bytes, result));
+        }
+        std::printf(
+                " %10.1f %10.1f %10.1f\n",
+                perEntry(result.memoryUsage.lessOrEqualToMedian.getTotal(),
+                         result),
+                perEntry(result.memoryUsage.greaterThanMedian.getTotal(),
+                         result),
+                perEntry(result.mallocBytes, result));
+    }
+}
+
+void printJson(const std::vector<Result> &results) {
+    std::printf("{\n  \"benchmarks\": [");
+    for (unsigned long i = 0; i < results.size(); i++) {
+        const Result &result = results[i];
+        MemoryUsage   total  = result.memoryUsage.getTotal();
+        std::printf("%s\n    {\"size\": %lu, \"bytes\": %lu, "
+                    "\"bytesPerEntry\": %.3f",
+                    (i == 0) ? "" : ",", result.size, total.getTotal(),
+                    perEntry(total.getTotal(), result));
+        for (const Part &part : PARTS) {
+            std::printf(", \"%s\": %lu", part.name, total.*part.bytes);
+        }
+        std::printf(", \"lessOrEqualToMedian\": %lu, "
+                    "\"greaterThanMedian\": %lu, \"shared\": %lu, "
+                    "\"mallocBytes\": %lu}",
+                    result.memoryUsage.lessOrEqualToMedian.getTotal(),
+                    result.memoryUsage.greaterThanMedian.getTotal(),
+                    result.memoryUsage.shared.getTotal(), result.mallocBytes);
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long minimumSize        = 1000;
+    unsigned long maximumSize        = 1000000;
+    unsigned long valueLength        = 8;
+    double        physicalSizeFactor = 1;
+    bool          isJson             = false;
+    try {
+        for (int i = 1; i < argc; i++) {
+            if ((std::strcmp(argv[i], "--min-size") == 0) && (i + 1 < argc)) {
+                minimumSize = (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--max-size") == 0) &&
+                       (i + 1 < argc)) {
+                maximumSize = (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--value-length") == 0) &&
+                       (i + 1 < argc)) {
+                valueLength = std::stoul(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--physical-size-factor") == 0) &&
+                       (i + 1 < argc)) {
+                physicalSizeFactor = std::stod(argv[++i]);
+            } else if (std::strcmp(argv[i], "--json") == 0) {
+                isJson = true;
+            } else {
+                throw std::invalid_argument(argv[i]);
+            }
+        }
+        if ((minimumSize < 1) || !(physicalSizeFactor >= 0.5)) {
+            throw std::invalid_argument("--min-size");
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Usage: memoryBenchmark [--min-size N] [--max-size N] "
+                     "[--value-length N]\n"
+                     "    [--physical-size-factor F] [--json]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<Result> results;
+    for (unsigned long size = minimumSize; size <= maximumSize; size *= 10) {
+        results.push_back(measure(size, valueLength, physicalSizeFactor));
+    }
+    if (isJson) {
+        printJson(results);
+    } else {
+        printTable(results);
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+
+#ifndef PERF_EVENT_COUNTERS_H
+#define PERF_EVENT_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#if defined(__NR_perf_event_open)
+#define PERF_EVENT_SUPPORTED
+#endif
+#endif
+
+/**
+ * @brief The *hardware performance counters* of the CPU - cycles,
+ *        instructions, L1 data-cache misses, last-level-cache misses and
+ *        branch misses - of the calling thread, counted only between
+ *        @link start @endlink and @link stop @endlink, through the Linux
+ *        `perf_event_open` system-call.
+ *
+ * Each counter is opened on its own, so a counter that the CPU, the kernel
+ * or the sandbox does not allow (for example, in a virtual machine, or
+ * with a `perf_event_paranoid` of `3`) is not an error: it is only not
+ * available - see @link isAvailable @endlink - while the others still
+ * count. Only the user-space of the thread is counted.
+ *
+ * For example:
+ * @code
+ * PerfEventCounters counters;
+ * counters.start();
+ * heap.fixHeap(0);
+ * counters.stop();
+ * if (counters.isAvailable(PerfEventCounters::L1D_MISSES)) {
+ *     std::printf("%lu\n", counters.getValue(PerfEventCounters::L1D_MISSES));
+ * }
+ * @endcode
+ *
+ * @note when the kernel *multiplexes* the counters - as there are more
+ *       counters than the CPU has - each value is scaled by the share of
+ *       the time it was actually counted.
+ * @version 1.0
+ */
+class PerfEventCounters {
+
+  public:
+    /// The counters - indices of @link getValue @endlink.
+    enum Counter {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        COUNTER_COUNT
+    };
+
+  public:
+    /// The name of each `Counter`.
+    static constexpr const char *NAMES[COUNTER_COUNT] = {
+            "cycles", "instructions", "L1d-misses", "LLC-misses",
+            "branch-misses"};
+
+  protected:
+    /// The file-descriptor of each counter. `-1` when it is not available.
+    int _fds[COUNTER_COUNT] = {-1, -1, -1, -1, -1};
+
+  protected:
+    /// The value of each counter, summed over all the sections counted.
+    std::uint64_t _values[COUNTER_COUNT] = {};
+
+  public:
+    /// @brief Opens all the counters that are available - disabled.
+    PerfEventCounters() {
+#ifdef PERF_EVENT_SUPPORTED
+        _fds[CYCLES] =
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        _fds[INSTRUCTIONS] =
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        _fds[L1D_MISSES] =
+                open(PERF_TYPE_HW_CACHE,
+                     PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        _fds[LLC_MISSES] =
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        _fds[BRANCH_MISSES] =
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+  public:
+    PerfEventCounters(const PerfEventCounters &other) = delete;
+
+  public:
+    PerfEventCounters &operator=(const PerfEventCounters &other) = delete;
+
+  public:
+    virtual ~PerfEventCounters() {
+        for (int fd : _fds) {
+            if (fd >= 0) { ::close(fd); }
+        }
+    }
+
+  public:
+    /// @return whether the given @p counter is counted.
+    bool isAvailable(Counter counter) const { return _fds[counter] >= 0; }
+
+  public:
+    /// @return whether any of the counters is counted.
+    bool isAnyAvailable() const {
+        for (int fd : _fds) {
+            if (fd >= 0) { return true; }
+        }
+        return false;
+    }
+
+  public:
+    /// @brief Starts counting a section - from `0`.
+    void start() {
+#ifdef PERF_EVENT_SUPPORTED
+        for (int fd : _fds) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+  public:
+    /// @brief Stops counting the section, and adds it to the values.
+    void stop() {
+#ifdef PERF_EVENT_SUPPORTED
+        for (int fd : _fds) {
+            if (fd >= 0) { ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); }
+        }
+        for (unsigned long i = 0; i < COUNTER_COUNT; i++) {
+            if (_fds[i] >= 0) { _values[i] += read(_fds[i]); }
+        }
+#endif
+    }
+
+  public:
+    /**
+     * @return the value of the given @p counter, summed over all the
+     *         sections counted - `0` in case it is not available.
+     */
+    std::uint64_t getValue(Counter counter) const { return _values[counter]; }
+
+#ifdef PERF_EVENT_SUPPORTED
+  protected:
+    /// @return the file-descriptor of the counter, or `-1` on failure.
+    static int open(std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attributes {};
+        attributes.size           = sizeof(attributes);
+        attributes.type           = type;
+        attributes.config         = config;
+        attributes.disabled       = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+        attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                 PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int) ::syscall(__NR_perf_event_open, &attributes, 0, -1, -1,
+                               0);
+    }
+
+  protected:
+    /// @return the value of the counter - scaled, in case it was multiplexed.
+    static std::uint64_t read(int fd) {
+        std::uint64_t values[3] = {};
+        if (::read(fd, values, sizeof(values)) != (ssize_t) sizeof(values) ||
+            (values[2] == 0)) {
+            return 0;
+        }
+        if (values[2] == values[1]) { return values[0]; }
+        return (std::uint64_t) ((double) values[0] * (double) values[1] /
+                                (double) values[2]);
+    }
+#endif
+};
+
+#endif // PERF_EVENT_COUNTERS_H
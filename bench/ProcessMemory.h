@@ -0,0 +1,79 @@
+
+#ifndef PROCESS_MEMORY_H
+#define PROCESS_MEMORY_H
+
+#include <cstdio>
+#include <unistd.h>
+
+#if defined(__GLIBC__) && \
+        ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+#include <malloc.h>
+#define MALLINFO2_SUPPORTED
+#endif
+
+/**
+ * @brief A sample of the memory of the calling process - its *resident set
+ *        size* (RSS), from `/proc/self/statm`, and the statistics of
+ *        `malloc`, from `mallinfo2`.
+ *
+ * Either of them that is not available - on a system without `/proc`, or
+ * with a C library without `mallinfo2` - is `0`, and not an error.
+ *
+ * For example:
+ * @code
+ * ProcessMemory before = ProcessMemory::sample();
+ * ...
+ * ProcessMemory after = ProcessMemory::sample();
+ * std::printf("%lu\n", after.mallocInUseBytes - before.mallocInUseBytes);
+ * @endcode
+ *
+ * @version 1.0
+ */
+struct ProcessMemory {
+
+    /// Whether `mallinfo2` is available - else, its fields are all `0`.
+#ifdef MALLINFO2_SUPPORTED
+    static constexpr bool IS_MALLOC_STATISTICS_AVAILABLE = true;
+#else
+    static constexpr bool IS_MALLOC_STATISTICS_AVAILABLE = false;
+#endif
+
+    /// The bytes of the process that are resident in RAM.
+    unsigned long residentBytes = 0;
+
+    /// The bytes that `malloc` handed out - including the `mmap`ed ones.
+    unsigned long mallocInUseBytes = 0;
+
+    /// The bytes that `malloc` holds from the kernel - in use or not.
+    unsigned long mallocHeldBytes = 0;
+
+    /**
+     * The bytes that `malloc` holds and that are *free* - a growth of these,
+     * at a steady amount in use, is *fragmentation*.
+     */
+    unsigned long mallocFreeBytes = 0;
+
+    /// @return the memory of the calling process now.
+    static ProcessMemory sample() {
+        ProcessMemory memory;
+        FILE *        file = std::fopen("/proc/self/statm", "r");
+        if (file != nullptr) {
+            unsigned long size     = 0;
+            unsigned long resident = 0;
+            if (std::fscanf(file, "%lu %lu", &size, &resident) == 2) {
+                memory.residentBytes =
+                        resident * (unsigned long) ::sysconf(_SC_PAGESIZE);
+            }
+            std::fclose(file);
+        }
+#ifdef MALLINFO2_SUPPORTED
+        struct mallinfo2 info   = mallinfo2();
+        memory.mallocInUseBytes = info.uordblks + info.hblkhd;
+        memory.mallocHeldBytes  = info.arena + info.hblkhd;
+        memory.mallocFreeBytes  = info.fordblks;
+#endif
+        return memory;
+    }
+};
+
+#endif // PROCESS_MEMORY_H
@@ -0,0 +1,227 @@
+#include "AsyncFileReader.h"
+#include "BinaryProtocol.h"
+#include "BufferedReader.h"
+#include "CommandDecoder.h"
+#include "Input.h"
+#include "MappedFile.h"
+#include "StructuralLineReader.h"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Measures the throughput of reading a command file line by line, in
+ *        MB/s - for each of the line readers of the program.
+ *
+ * Usage:
+ * @code
+ * readerBenchmark [sizeInMB] [file]
+ * @endcode
+ * @li `sizeInMB` the size of the command file generated. Defaults to `64`.
+ * @li `file` the path of the command file generated. Defaults to a file in
+ *     `/tmp`. The file is deleted afterwards.
+ *
+ * The same commands are also read in the binary format of the
+ * `BinaryProtocol` - reported in MB/s of the *text* file, so that all of
+ * the readers are compared on the same amount of commands.
+ */
+
+namespace {
+
+/// Reads all the lines of the file in the given path, and counts them.
+typedef std::function<unsigned long(const std::string &)> ReadAllLines;
+
+/// Writes a command file of about @p size bytes, in the program's format.
+void generateCommandFile(const std::string &path, unsigned long size) {
+    std::ofstream file(path, std::ios::binary);
+    std::string   line;
+    unsigned long written = 0;
+    file << "1\ne\n";
+    for (unsigned long i = 0; written < size; i++) {
+        line = "f " + std::to_string((long) (i * 2654435761UL % 2000001) -
+                                     1000000) +
+               " value number " + std::to_string(i) + "\n";
+        file << line;
+        written += line.size();
+    }
+}
+
+/**
+ * @brief Writes the commands of the text command file in @p textPath, in the
+ *        binary format of the `BinaryProtocol`, to @p binaryPath.
+ *
+ * @note the number of commands declared is the *actual* number of them.
+ */
+void generateBinaryCommandFile(const std::string &textPath,
+                               const std::string &binaryPath) {
+    MappedFile              file(textPath);
+    std::string             commands;
+    std::string_view        line;
+    CommandDecoder::Command command;
+    unsigned long           i = 0;
+    file.getLine(line);
+    for (; file.getLine(line); i++) {
+        CommandDecoder::decode(line, i, command);
+        BinaryProtocol::appendCommand(commands, command);
+    }
+
+    std::string header;
+    BinaryProtocol::appendHeader(header, BinaryProtocol::COMMANDS_MAGIC);
+    BinaryProtocol::appendVarint(header, i);
+    std::ofstream(binaryPath, std::ios::binary) << header << commands;
+}
+
+/**
+ * @brief Invokes the given @p readAllLines function on the file in @p path,
+ *        and prints its throughput.
+ */
+void measure(const std::string &name, const std::string &path,
+             unsigned long fileSize, const ReadAllLines &readAllLines) {
+    auto          start     = std::chrono::steady_clock::now();
+    unsigned long lineCount = readAllLines(path);
+    auto          end       = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("%-32s %10lu lines %10.1f MB/s\n", name.c_str(), lineCount,
+                (double) fileSize / (1 << 20) / seconds);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long sizeInMB = 64;
+    std::string   path     = "/tmp/readerBenchmark.commands.txt";
+    try {
+        if (argc > 3) { throw std::invalid_argument(argv[3]); }
+        if (argc > 1) {
+            std::size_t length = 0;
+            sizeInMB           = std::stoul(argv[1], &length);
+            if (!std::isdigit((unsigned char) argv[1][0]) ||
+                (argv[1][length] != '\0') || (sizeInMB < 1)) {
+                throw std::invalid_argument(argv[1]);
+            }
+        }
+        if (argc > 2) { path = argv[2]; }
+    } catch (std::exception &e) {
+        std::cerr << "Usage: readerBenchmark [sizeInMB] [file]" << std::endl;
+        return 1;
+    }
+
+    generateCommandFile(path, sizeInMB << 20);
+    std::ifstream sizeFile(path, std::ios::binary | std::ios::ate);
+    auto          fileSize = (unsigned long) sizeFile.tellg();
+
+    measure("Input::getLine(std::istream &)", path, fileSize,
+            [](const std::string &path) {
+                std::ifstream file(path, std::ios::binary);
+                unsigned long lineCount = 0;
+                while (!Input::getLine(file).empty()) { lineCount++; }
+                return lineCount;
+            });
+
+    measure("BufferedReader(std::istream &)", path, fileSize,
+            [](const std::string &path) {
+                std::ifstream    file(path, std::ios::binary);
+                BufferedReader   reader(file);
+                unsigned long    lineCount = 0;
+                std::string_view line;
+                while (reader.getLine(line)) { lineCount++; }
+                return lineCount;
+            });
+
+    measure("BufferedReader(int fd)", path, fileSize,
+            [](const std::string &path) {
+                int              fd = ::open(path.c_str(), O_RDONLY);
+                BufferedReader   reader(fd);
+                unsigned long    lineCount = 0;
+                std::string_view line;
+                while (reader.getLine(line)) { lineCount++; }
+                ::close(fd);
+                return lineCount;
+            });
+
+    measure(std::string("AsyncFileReader (") +
+                    (AsyncFileReader(path).isAsynchronous() ? "io_uring"
+                                                            : "pread") +
+                    ")",
+            path, fileSize, [](const std::string &path) {
+                AsyncFileReader  reader(path);
+                unsigned long    lineCount = 0;
+                std::string_view line;
+                while (reader.getLine(line)) { lineCount++; }
+                return lineCount;
+            });
+
+    measure("MappedFile", path, fileSize, [](const std::string &path) {
+        MappedFile       file(path);
+        unsigned long    lineCount = 0;
+        std::string_view line;
+        while (file.getLine(line)) { lineCount++; }
+        return lineCount;
+    });
+
+    measure("MappedFile + decode", path, fileSize,
+            [](const std::string &path) {
+                MappedFile              file(path);
+                unsigned long           lineCount = 0;
+                std::string_view        line;
+                CommandDecoder::Command command;
+                file.getLine(line);
+                while (file.getLine(line)) {
+                    CommandDecoder::decode(line, lineCount++, command);
+                }
+                return lineCount + 1;
+            });
+
+    measure(std::string("StructuralLineReader (") +
+                    StructuralScanner::getInstructionSetName() + ")",
+            path, fileSize, [](const std::string &path) {
+                MappedFile           file(path);
+                StructuralLineReader reader(file.getView());
+                unsigned long        lineCount = 0;
+                std::string_view     line;
+                while (reader.getLine(line)) { lineCount++; }
+                return lineCount;
+            });
+
+    measure("StructuralLineReader + decode", path, fileSize,
+            [](const std::string &path) {
+                MappedFile              file(path);
+                StructuralLineReader    reader(file.getView());
+                unsigned long           lineCount = 0;
+                std::string_view        line;
+                CommandDecoder::Command command;
+                reader.getLine(line);
+                while (reader.getLine(line)) {
+                    CommandDecoder::decode(line, lineCount++, command,
+                                           reader.getKeyEnd());
+                }
+                return lineCount + 1;
+            });
+
+    std::string binaryPath = path + ".bin";
+    generateBinaryCommandFile(path, binaryPath);
+    measure("MappedFile + binary decode", binaryPath, fileSize,
+            [](const std::string &path) {
+                MappedFile              file(path);
+                CommandDecoder::Command command;
+                BinaryProtocol::readHeader(file,
+                                           BinaryProtocol::COMMANDS_MAGIC);
+                unsigned long lineCount =
+                        BinaryProtocol::readNumberOfCommands(file);
+                for (unsigned long i = 0; i < lineCount; i++) {
+                    BinaryProtocol::readCommand(file, i, command);
+                }
+                return lineCount + 1;
+            });
+
+    std::remove(binaryPath.c_str());
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,280 @@
+#include "CommandDecoder.h"
+#include "PriorityQueueKv.h"
+#include "bench/ProcessMemory.h"
+#include "tools/WorkloadGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Drives a `PriorityQueueKv` through a long *churn* of inserts and
+ *        deletes at a steady size, and samples its throughput and the
+ *        memory of the process over time - to catch a growth of the memory,
+ *        or a decay of the throughput, that only shows after hours.
+ *
+ * Usage:
+ * @code
+ * soakBenchmark [--duration S] [--interval S] [--size N]
+ *               [--keys uniform | zipf | sorted | reverse | sawtooth |
+ *                       duplicates | adversarial]
+ *               [--values fixed | uniform | geometric] [--value-length N]
+ *               [--seed S] [--json]
+ * @endcode
+ * @li `--duration` the amount of seconds to run. Defaults to `60` - run it
+ *     for hours to soak.
+ * @li `--interval` the amount of seconds between samples. Defaults to `1`.
+ * @li `--size` the steady amount of entries. Defaults to `1000000`.
+ * @li `--keys`, `--values` and `--value-length` - see `WorkloadGenerator`.
+ *     The values default to `geometric` lengths of `32` on average, so that
+ *     most of them are allocated by `malloc`, in various sizes.
+ *
+ * The methods are the commands of the `WorkloadGenerator`, with its default
+ * mix - which grows the `PriorityQueueKv` up to `--size` entries, and then
+ * keeps it there, as an insert into a full `PriorityQueueKv` is replaced by
+ * a delete. The samples start once it is full. Each sample is a line of:
+ * @li `ops/s` - the throughput since the sample before it.
+ * @li `RSS` - the resident set size of the process.
+ * @li `in use`, `held` and `free` - the bytes that `malloc` handed out,
+ *     holds from the kernel, and holds free - see `ProcessMemory`. A growth
+ *     of `free` at a steady `in use` is *fragmentation*.
+ * @li `logical` - the bytes of `PriorityQueueKv::memoryUsage`.
+ *
+ * At the end, the last sample is compared to the first one.
+ *
+ * @note measure an optimized build - for example, configured with
+ *       `-DCMAKE_BUILD_TYPE=Release`.
+ */
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// The amount of methods invoked between two reads of the clock.
+constexpr unsigned long CLOCK_READ_INTERVAL = 1024;
+
+/// A single sample.
+struct Sample {
+
+    double seconds = 0;
+
+    unsigned long operationCount = 0;
+
+    double operationsPerSecond = 0;
+
+    unsigned long size = 0;
+
+    ProcessMemory memory;
+
+    unsigned long logicalBytes = 0;
+};
+
+/// Keeps the results of the methods from being optimized away.
+volatile long sink = 0;
+
+/// Invokes the method of the given @p command on the given @p queue.
+void invoke(PriorityQueueKv<int, std::string> &queue,
+            const CommandDecoder::Command &    command) {
+    switch (command.opcode) {
+        case 'a':
+            sink = sink + queue.max().getKey();
+            break;
+        case 'b':
+            sink = sink + queue.deleteMax().getKey();
+            break;
+        case 'c':
+            sink = sink + queue.min().getKey();
+            break;
+        case 'd':
+            sink = sink + queue.deleteMin().getKey();
+            break;
+        case 'f':
+            queue.insert(command.key, std::string(command.value));
+            break;
+        default:
+            sink = sink + queue.median().getKey();
+            break;
+    }
+}
+
+/// @return the change of the size of the queue by the given @p command.
+long getSizeChange(const CommandDecoder::Command &command) {
+    if (command.opcode == CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) {
+        return 1;
+    }
+    return ((command.opcode == 'b') || (command.opcode == 'd')) ? -1 : 0;
+}
+
+double toMegabytes(unsigned long bytes) {
+    return (double) bytes / (1 << 20);
+}
+
+void printHeader() {
+    std::printf("%10s %14s %12s %10s %10s %10s %10s %10s %10s\n", "seconds",
+                "operations", "ops/s", "size", "RSS (MB)", "in use", "held",
+                "free", "logical");
+}
+
+void printSample(const Sample &sample) {
+    std::printf("%10.1f %14lu %12.0f %10lu %10.1f %10.1f %10.1f %10.1f "
+                "%10.1f\n",
+                sample.seconds, sample.operationCount,
+                sample.operationsPerSecond, sample.size,
+                toMegabytes(sample.memory.residentBytes),
+                toMegabytes(sample.memory.mallocInUseBytes),
+                toMegabytes(sample.memory.mallocHeldBytes),
+                toMegabytes(sample.memory.mallocFreeBytes),
+                toMegabytes(sample.logicalBytes));
+    std::fflush(stdout);
+}
+
+/// @brief Prints the change from the @p first sample to the @p last one.
+void printSummary(const Sample &first, const Sample &last) {
+    std::printf("from the first sample to the last: throughput %+.1f%%, "
+                "RSS %+.1f MB, malloc in use %+.1f MB, free %+.1f MB\n",
+                100 * (last.operationsPerSecond / first.operationsPerSecond -
+                       1),
+                toMegabytes(last.memory.residentBytes) -
+                        toMegabytes(first.memory.residentBytes),
+                toMegabytes(last.memory.mallocInUseBytes) -
+                        toMegabytes(first.memory.mallocInUseBytes),
+                toMegabytes(last.memory.mallocFreeBytes) -
+                        toMegabytes(first.memory.mallocFreeBytes));
+}
+
+void printJson(const std::vector<Sample> &samples) {
+    std::printf("{\n  \"samples\": [");
+    for (unsigned long i = 0; i < samples.size(); i++) {
+        const Sample &sample = samples[i];
+        std::printf("%s\n    {\"seconds\": %.3f, \"operations\": %lu, "
+                    "\"operationsPerSecond\": %.1f, \"size\": %lu, "
+                    "\"residentBytes\": %lu, \"mallocInUseBytes\": %lu, "
+                    "\"mallocHeldBytes\": %lu, \"mallocFreeBytes\": %lu, "
+                    "\"logicalBytes\": %lu}",
+                    (i == 0) ? "" : ",", sample.seconds,
+                    sample.operationCount, sample.operationsPerSecond,
+                    sample.size, sample.memory.residentBytes,
+                    sample.memory.mallocInUseBytes,
+                    sample.memory.mallocHeldBytes,
+                    sample.memory.mallocFreeBytes, sample.logicalBytes);
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    double                     duration = 60;
+    double                     interval = 1;
+    bool                       isJson   = false;
+    WorkloadGenerator::Options options;
+    options.maximumLiveCount = 1000000;
+    options.valueLength      = 32;
+    options.valueLengthDistribution =
+            WorkloadGenerator::ValueLengthDistribution::GEOMETRIC;
+    try {
+        for (int i = 1; i < argc; i++) {
+            if ((std::strcmp(argv[i], "--duration") == 0) && (i + 1 < argc)) {
+                duration = std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--interval") == 0) &&
+                       (i + 1 < argc)) {
+                interval = std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--size") == 0) &&
+                       (i + 1 < argc)) {
+                options.maximumLiveCount =
+                        (unsigned long) std::stod(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--keys") == 0) &&
+                       (i + 1 < argc)) {
+                options.keyDistribution =
+                        WorkloadGenerator::getKeyDistribution(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--values") == 0) &&
+                       (i + 1 < argc)) {
+                options.valueLengthDistribution =
+                        WorkloadGenerator::getValueLengthDistribution(
+                                argv[++i]);
+            } else if ((std::strcmp(argv[i], "--value-length") == 0) &&
+                       (i + 1 < argc)) {
+                options.valueLength = std::stoul(argv[++i]);
+            } else if ((std::strcmp(argv[i], "--seed") == 0) &&
+                       (i + 1 < argc)) {
+                options.seed = std::stoul(argv[++i]);
+            } else if (std::strcmp(argv[i], "--json") == 0) {
+                isJson = true;
+            } else {
+                throw std::invalid_argument(argv[i]);
+            }
+        }
+        if (!(duration > 0) || !(interval > 0) ||
+            (options.maximumLiveCount < 1)) {
+            throw std::invalid_argument("--duration");
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Usage: soakBenchmark [--duration S] [--interval S] "
+                     "[--size N]\n"
+                     "    [--keys uniform | zipf | sorted | reverse | "
+                     "sawtooth | duplicates | adversarial]\n"
+                     "    [--values fixed | uniform | geometric] "
+                     "[--value-length N] [--seed S] [--json]"
+                  << std::endl;
+        return 1;
+    }
+
+    WorkloadGenerator                 generator(options);
+    CommandDecoder::Command           command;
+    PriorityQueueKv<int, std::string> queue(
+            (int) options.maximumLiveCount + 1);
+
+    // Grow the `PriorityQueueKv` up to its steady size.
+    unsigned long size = 0;
+    while (size < options.maximumLiveCount) {
+        generator.nextCommand(command);
+        invoke(queue, command);
+        size += getSizeChange(command);
+    }
+
+    std::vector<Sample> samples;
+    if (!isJson) { printHeader(); }
+    unsigned long     operationCount = 0;
+    Clock::time_point start          = Clock::now();
+    Clock::time_point lastSample     = start;
+    unsigned long     lastCount      = 0;
+    for (bool isDone = false; !isDone;) {
+        for (unsigned long i = 0; i < CLOCK_READ_INTERVAL; i++) {
+            generator.nextCommand(command);
+            invoke(queue, command);
+            size += getSizeChange(command);
+        }
+        operationCount += CLOCK_READ_INTERVAL;
+
+        Clock::time_point now = Clock::now();
+        double sinceLastSample =
+                std::chrono::duration<double>(now - lastSample).count();
+        if (sinceLastSample < interval) { continue; }
+
+        Sample sample;
+        sample.seconds = std::chrono::duration<double>(now - start).count();
+        sample.operationCount = operationCount;
+        sample.operationsPerSecond =
+                (double) (operationCount - lastCount) / sinceLastSample;
+        sample.size         = size;
+        sample.memory       = ProcessMemory::sample();
+        sample.logicalBytes = queue.memoryUsage().getTotal().getTotal();
+        samples.push_back(sample);
+        if (!isJson) { printSample(sample); }
+
+        isDone    = sample.seconds >= duration;
+        lastCount = operationCount;
+
+        // Sampling is not part of the next interval.
+        lastSample = Clock::now();
+    }
+
+    if (isJson) {
+        printJson(samples);
+    } else {
+        printSummary(samples.front(), samples.back());
+    }
+    return 0;
+}
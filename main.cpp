@@ -1,21 +1,111 @@
+#include "BinaryProtocol.h"
+#include "CommandStatistics.h"
 #include "Constants.h"
 #include "Input.h"
 #include "TestRunner.h"
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
 
 /**
  * @mainpage mivnei_netunim targil tichnuti 2
  *
+ * Usage:
+ * @code
+ * mivneiNetunimEx2                  // Gets the "tests" from the standard input.
+ * mivneiNetunimEx2 --input <file>   // Gets the "tests" from the <file>.
+ * @endcode
+ *
+ * Options:
+ * @li `--pipeline` - parses, executes and writes the results of the "tests"
+ *     on 3 separate threads. See `TestRunner::runAllTestsPipelined`.
+ * @li `--pin-cpus` - with `--pipeline`, pins each of the 3 threads to its own
+ *     CPU.
+ * @li `--parallel-parse` - with `--input` of a regular text file, parses the
+ *     "tests" on multiple threads. See `ParallelCommandParser`.
+ * @li `--async-read` - with `--input` of a regular file, reads the file in
+ *     blocks that are read ahead asynchronously, instead of mapping it. See
+ *     `AsyncFileReader`.
+ * @li `--structural-index` - with `--input` of a regular text file, reads
+ *     its lines by a structural index of it. See `StructuralLineReader`.
+ * @li `--stats` - records how long each "test" took to be parsed, executed
+ *     and written, and prints a summary of the latencies of each letter to
+ *     the standard error at exit. The results are not changed. See
+ *     `CommandStatistics`.
+ * @li `--stats-file <file>` - the same as `--stats`, to the <file> instead.
+ *
+ * The "tests" may also be in the *binary* format of the `BinaryProtocol` -
+ * and then the results are written in the binary format as well. See
+ * `tools/BinaryConverter.cpp` to convert between the two formats.
+ *
  * @author Tal Yacob, ID: 208632778.
- * @version 1.0
+ * @version 1.6
  */
-int main() {
+int main(int argc, char **argv) {
+    std::unique_ptr<CommandStatistics> statistics;
+    std::ofstream                      statisticsFile;
+    int                                result = 0;
     try {
-        TestRunner::getTestArrayAndRunAllTests();
+        TestRunner::Options options;
+        const char *        inputPath      = nullptr;
+        const char *        statisticsPath = nullptr;
+        bool                isStatistics   = false;
+        for (int i = 1; i < argc; i++) {
+            if ((std::strcmp(argv[i], "--input") == 0) && (i + 1 < argc) &&
+                (inputPath == nullptr)) {
+                inputPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--pipeline") == 0) {
+                options.isPipelined = true;
+            } else if (std::strcmp(argv[i], "--pin-cpus") == 0) {
+                options.isPinned = true;
+            } else if (std::strcmp(argv[i], "--parallel-parse") == 0) {
+                options.isParsedInParallel = true;
+            } else if (std::strcmp(argv[i], "--async-read") == 0) {
+                options.isReadAsynchronously = true;
+            } else if (std::strcmp(argv[i], "--structural-index") == 0) {
+                options.isStructurallyIndexed = true;
+            } else if (std::strcmp(argv[i], "--stats") == 0) {
+                isStatistics = true;
+            } else if ((std::strcmp(argv[i], "--stats-file") == 0) &&
+                       (i + 1 < argc) && (statisticsPath == nullptr)) {
+                statisticsPath = argv[++i];
+                isStatistics   = true;
+            } else {
+                throw std::runtime_error(Constants::WRONG_INPUT);
+            }
+        }
+        if ((options.isPinned && !options.isPipelined) ||
+            (isStatistics && options.isPipelined)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+        if (statisticsPath != nullptr) {
+            statisticsFile.open(statisticsPath);
+            if (!statisticsFile) {
+                throw std::runtime_error(Constants::WRONG_INPUT);
+            }
+        }
+        if (isStatistics) {
+            statistics         = std::make_unique<CommandStatistics>();
+            options.statistics = statistics.get();
+        }
+
+        if (inputPath != nullptr) {
+            TestRunner::getTestArrayAndRunAllTestsFromFile(inputPath, options);
+        } else {
+            TestRunner::getTestArrayAndRunAllTests(options);
+        }
+    } catch (BinaryProtocol::ErrorWritten &e) {
+        result = Constants::MAIN_ERROR;
     } catch (std::exception &e) {
         std::cout << Constants::WRONG_INPUT << std::endl;
-        return Constants::MAIN_ERROR;
+        result = Constants::MAIN_ERROR;
     }
 
-    return 0;
+    // The statistics are printed even after a wrong input.
+    if (statistics != nullptr) {
+        statistics->print(statisticsFile.is_open() ? statisticsFile
+                                                   : std::cerr);
+    }
+    return result;
 }
@@ -0,0 +1,79 @@
+#include "BaseArray.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+
+/**
+ * @brief Checks that move-assigning a `BaseArray` whose allocator does not
+ *        propagate - a `std::pmr::polymorphic_allocator` over another
+ *        `std::pmr::monotonic_buffer_resource` - moves the elements to a
+ *        buffer of its own resource, instead of taking the buffer of the
+ *        other resource.
+ *
+ * Exits with `1` and prints the failure on the first mismatch.
+ */
+
+namespace {
+
+typedef std::pmr::polymorphic_allocator<std::string> Allocator;
+
+typedef BaseArray<std::string, Allocator> Array;
+
+/// The size of the arrays - larger than the inline capacity.
+constexpr unsigned long SIZE = 16;
+
+/// @return whether the given @p pointer is within the given @p buffer.
+template<unsigned long N>
+bool isWithin(const void *pointer, const char (&buffer)[N]) {
+    const auto *bytes = (const char *) pointer;
+    return (buffer <= bytes) && (bytes < buffer + N);
+}
+
+/// @brief Fails with the given @p message, unless @p condition holds.
+void check(bool condition, const char *message) {
+    if (!condition) {
+        std::cerr << message << std::endl;
+        std::exit(1);
+    }
+}
+
+/// @brief Checks a move-assignment of an array of the given @p size.
+void checkMoveAssignment(unsigned long size) {
+    static char sourceBuffer[1 << 14];
+    static char destinationBuffer[1 << 14];
+    std::pmr::monotonic_buffer_resource sourceResource(
+            sourceBuffer, sizeof(sourceBuffer),
+            std::pmr::null_memory_resource());
+    std::pmr::monotonic_buffer_resource destinationResource(
+            destinationBuffer, sizeof(destinationBuffer),
+            std::pmr::null_memory_resource());
+
+    Array source(size, Allocator(&sourceResource));
+    for (unsigned long i = 0; i < size; i++) {
+        source.setElement(std::string(40, (char) ('a' + i)), i);
+    }
+    Array destination(1, Allocator(&destinationResource));
+    destination = std::move(source);
+
+    check(destination.size() == size, "the size was not moved");
+    check(source.size() == 0, "the source was not emptied");
+    for (unsigned long i = 0; i < size; i++) {
+        const std::string &element = destination.getElement(i);
+        check(element == std::string(40, (char) ('a' + i)),
+              "an element was not moved");
+        check(!isWithin(&element, sourceBuffer),
+              "the buffer of the other resource was taken");
+        check((size <= Array::INLINE_CAPACITY) ||
+                      isWithin(&element, destinationBuffer),
+              "an element was not moved into its own resource");
+    }
+}
+
+} // namespace
+
+int main() {
+    checkMoveAssignment(Array::INLINE_CAPACITY);
+    checkMoveAssignment(SIZE);
+    return 0;
+}
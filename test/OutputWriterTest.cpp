@@ -0,0 +1,78 @@
+#include "OutputWriter.h"
+#include <climits>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @brief Checks that an `OutputWriter` writes the same output with any size
+ *        of buffer - including buffers smaller than the longest integer -
+ *        and with any `FlushPolicy`.
+ *
+ * Exits with `1` and prints the difference on the first mismatch.
+ */
+
+namespace {
+
+/// @return what the given @p writeAll wrote through an `OutputWriter`.
+template<typename WriteAll>
+std::string capture(OutputWriter::FlushPolicy policy, unsigned long bufferSize,
+                    WriteAll writeAll) {
+    int fds[2];
+    if (::pipe(fds) != 0) { throw std::runtime_error("pipe"); }
+    {
+        OutputWriter writer(fds[1], policy, bufferSize);
+        writeAll(writer);
+        writer.flush();
+    }
+    ::close(fds[1]);
+
+    std::string output;
+    char        buffer[256];
+    long        length;
+    while ((length = (long) ::read(fds[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, length);
+    }
+    ::close(fds[0]);
+    return output;
+}
+
+void writeAll(OutputWriter &writer) {
+    writer.write(INT_MIN);
+    writer.write(' ');
+    writer.write(INT_MAX);
+    writer.endLine();
+    writer.write(LONG_MIN);
+    writer.write(' ');
+    writer.write(ULONG_MAX);
+    writer.endLine();
+    writer.write(Entry<int, std::string>(-7, "a value longer than a buffer"));
+    writer.endLine();
+    writer.write(0);
+    writer.endLine();
+}
+
+} // namespace
+
+int main() {
+    std::string expected = std::to_string(INT_MIN) + " " +
+                           std::to_string(INT_MAX) + "\n" +
+                           std::to_string(LONG_MIN) + " " +
+                           std::to_string(ULONG_MAX) + "\n" +
+                           "-7 a value longer than a buffer\n0\n";
+    for (auto policy : {OutputWriter::FlushPolicy::SIZE,
+                        OutputWriter::FlushPolicy::LINE,
+                        OutputWriter::FlushPolicy::EXPLICIT}) {
+        for (unsigned long bufferSize = 1; bufferSize <= 64; bufferSize++) {
+            std::string output = capture(policy, bufferSize, writeAll);
+            if (output != expected) {
+                std::cerr << "bufferSize " << bufferSize << ", policy "
+                          << (int) policy << ":\n"
+                          << output << "instead of:\n"
+                          << expected;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
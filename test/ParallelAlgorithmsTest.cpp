@@ -0,0 +1,138 @@
+#include "BaseArray.h"
+#include "BasicAlgorithms.h"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Checks that the *parallel* methods of `BaseArray` - and the
+ *        `BasicAlgorithms::parallelForEachChunk` beneath them - give exactly
+ *        the same results as their *serial* versions, for sizes below, at,
+ *        and above `BasicAlgorithms::PARALLEL_MINIMUM_CHUNK_SIZE`.
+ *
+ * The amount of threads is given explicitly, so that the range is divided
+ * to multiple chunks even on a machine with a single hardware thread.
+ *
+ * Exits with `1` and prints the failure on the first mismatch.
+ */
+
+namespace {
+
+constexpr unsigned long THREAD_COUNT = 4;
+
+/// @brief Fails with the given @p message, unless @p condition holds.
+void check(bool condition, const char *message, unsigned long size) {
+    if (!condition) {
+        std::cerr << message << " - size " << size << std::endl;
+        std::exit(1);
+    }
+}
+
+/// @return an array of the given @p size, of pseudo-random values.
+BaseArray<long> createArray(unsigned long size) {
+    BaseArray<long> array(size);
+    unsigned long   state = size;
+    for (unsigned long i = 0; i < size; i++) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        array.setElement((long) (state >> 33), i);
+    }
+    return array;
+}
+
+bool isEqual(BaseArray<long> &array1, BaseArray<long> &array2) {
+    if (array1.size() != array2.size()) { return false; }
+    for (unsigned long i = 0; i < array1.size(); i++) {
+        if (array1.getElement(i) != array2.getElement(i)) { return false; }
+    }
+    return true;
+}
+
+void checkChunks(unsigned long size) {
+    unsigned long expectedChunkCount =
+            BasicAlgorithms::getChunkCount(size, THREAD_COUNT);
+    std::vector<unsigned long> begins(expectedChunkCount);
+    std::vector<unsigned long> ends(expectedChunkCount);
+    unsigned long              chunkCount =
+            BasicAlgorithms::parallelForEachChunk(
+                    size,
+                    [&](unsigned long chunkIndex, unsigned long begin,
+                        unsigned long end) {
+                        begins[chunkIndex] = begin;
+                        ends[chunkIndex]   = end;
+                    },
+                    THREAD_COUNT);
+    check(chunkCount == expectedChunkCount, "wrong amount of chunks", size);
+
+    // The chunks cover the whole range, in order.
+    unsigned long next = 0;
+    for (unsigned long i = 0; i < chunkCount; i++) {
+        check(begins[i] == next, "the chunks are not contiguous", size);
+        next = ends[i];
+    }
+    check(next == size, "the chunks do not cover the range", size);
+}
+
+void checkException(unsigned long size) {
+    bool isThrown = false;
+    try {
+        BasicAlgorithms::parallelForEachChunk(
+                size,
+                [&](unsigned long chunkIndex, unsigned long, unsigned long) {
+                    if (chunkIndex == 0) { throw std::runtime_error("chunk"); }
+                },
+                THREAD_COUNT);
+    } catch (std::runtime_error &e) { isThrown = true; }
+    check(isThrown, "the exception of a chunk was not rethrown", size);
+}
+
+void checkForEach(unsigned long size) {
+    BaseArray<long> serial   = createArray(size);
+    BaseArray<long> parallel = createArray(size);
+    serial.forEach([](long *element) { *element = *element * 3 + 1; });
+    parallel.parallelForEach([](long *element) { *element = *element * 3 + 1; },
+                             0, THREAD_COUNT);
+    check(isEqual(serial, parallel), "parallelForEach differs", size);
+}
+
+void checkFilter(unsigned long size) {
+    BaseArray<long> serial   = createArray(size);
+    BaseArray<long> parallel = createArray(size);
+    serial.filter([](long *element) { return *element % 3 != 0; });
+    parallel.parallelFilter([](long *element) { return *element % 3 != 0; },
+                            0, THREAD_COUNT);
+    check(isEqual(serial, parallel), "parallelFilter differs", size);
+}
+
+void checkMap(unsigned long size) {
+    BaseArray<long> array    = createArray(size);
+    auto            toString = [](long *element) {
+        return std::to_string(*element);
+    };
+    BaseArray<std::string> serial = array.map<std::string>(toString);
+    BaseArray<std::string> parallel =
+            array.parallelMap<std::string>(toString, 0, THREAD_COUNT);
+    check(serial.size() == parallel.size(), "parallelMap differs", size);
+    for (unsigned long i = 0; i < size; i++) {
+        check(serial.getElement(i) == parallel.getElement(i),
+              "parallelMap differs", size);
+    }
+}
+
+} // namespace
+
+int main() {
+    constexpr unsigned long CHUNK =
+            BasicAlgorithms::PARALLEL_MINIMUM_CHUNK_SIZE;
+    for (unsigned long size : {1UL, CHUNK - 1, CHUNK, 2 * CHUNK + 1,
+                               THREAD_COUNT * CHUNK + 3,
+                               (THREAD_COUNT + 2) * CHUNK + 7}) {
+        checkChunks(size);
+        checkException(size);
+        checkForEach(size);
+        checkFilter(size);
+        checkMap(size);
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include "BinaryProtocol.h"
+#include "BufferedReader.h"
+#include "CommandDecoder.h"
+#include "Constants.h"
+#include "Input.h"
+#include "OutputWriter.h"
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @brief Converts the commands, or the results, of the program between the
+ *        text format and the *binary* format of the `BinaryProtocol` - from
+ *        the standard input to the standard output.
+ *
+ * Usage:
+ * @code
+ * binaryConverter commands-to-binary < input1.txt > input1.bin
+ * binaryConverter commands-to-text   < input1.bin > input1.txt
+ * binaryConverter results-to-binary  < output1.txt > output1.bin
+ * binaryConverter results-to-text    < output1.bin > output1.txt
+ * @endcode
+ *
+ * Commands are converted as they are, so the program rejects the converted
+ * commands exactly where it rejects the original ones: a line that can not
+ * be decoded is converted to a `BinaryProtocol::INVALID_COMMAND_TAG`, and a
+ * number of commands that can not be decoded to `0` - and the conversion
+ * stops there, as the program does not read any further. Converted back to
+ * text, these are a `?` line and a `0` number of commands.
+ *
+ * @note a value that ends with multiple ' ' chars is merged by the text
+ *       format to a single one (see `CommandDecoder`) - so such a binary
+ *       value does not convert back to the same text.
+ */
+
+namespace {
+
+/// Converts text commands to binary commands.
+void convertCommandsToBinary(BufferedReader &reader, OutputWriter &writer) {
+    unsigned long numberOfCommands = 0;
+    try {
+        numberOfCommands =
+                CommandDecoder::decodeNumberOfCommands(Input::getLine(reader));
+    } catch (std::runtime_error &e) {
+
+        // Converted to `0` - which is rejected by the program as well.
+    }
+
+    std::string output;
+    BinaryProtocol::appendHeader(output, BinaryProtocol::COMMANDS_MAGIC);
+    BinaryProtocol::appendVarint(output, numberOfCommands);
+    writer.write(output);
+    if (numberOfCommands == 0) { return; }
+
+    // The same as `TestRunner`, the commands end with an empty line.
+    std::string_view        line;
+    CommandDecoder::Command command;
+    for (unsigned long i = 0; !((line = Input::getLine(reader)).empty());
+         i++) {
+        if (!CommandDecoder::tryDecode(line, i, command)) {
+            writer.write((char) BinaryProtocol::INVALID_COMMAND_TAG);
+            return;
+        }
+
+        output.clear();
+        BinaryProtocol::appendCommand(output, command);
+        writer.write(output);
+    }
+}
+
+/// Converts binary commands to text commands.
+void convertCommandsToText(BufferedReader &reader, OutputWriter &writer) {
+    BinaryProtocol::readHeader(reader, BinaryProtocol::COMMANDS_MAGIC);
+    std::uint64_t numberOfCommands = 0;
+    if (!BinaryProtocol::tryReadVarint(reader, numberOfCommands) ||
+        (numberOfCommands > (std::uint64_t) LONG_MAX)) {
+        throw std::runtime_error(Constants::WRONG_INPUT);
+    }
+    writer.write(numberOfCommands);
+    writer.endLine();
+
+    CommandDecoder::Command command;
+    char                    letter = 0;
+    for (unsigned long i = 0; i < numberOfCommands; i++) {
+        if (reader.peekByte(letter) &&
+            ((unsigned char) letter == BinaryProtocol::INVALID_COMMAND_TAG)) {
+            writer.write(letter);
+            writer.endLine();
+            return;
+        }
+        BinaryProtocol::readCommand(reader, i, command);
+        writer.write(command.opcode);
+        if (command.opcode == CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) {
+            writer.write(' ');
+            writer.write(command.key);
+            writer.write(' ');
+            writer.write(command.value);
+        }
+        writer.endLine();
+    }
+}
+
+/**
+ * @brief Converts text results to binary results.
+ * @return `Constants::MAIN_ERROR` if the results end with a wrong input.
+ *         Else, `0`.
+ */
+int convertResultsToBinary(BufferedReader &reader, OutputWriter &writer) {
+    BinaryProtocol::writeHeader(writer, BinaryProtocol::RESULTS_MAGIC);
+
+    std::string_view line;
+    while (reader.getLine(line)) {
+        if (line == Constants::WRONG_INPUT) {
+            BinaryProtocol::writeError(writer);
+            return Constants::MAIN_ERROR;
+        }
+
+        // The key is up to the first ' ', and the value is the rest.
+        unsigned long delimiter = line.find(' ');
+        int           key       = 0;
+        if ((delimiter == std::string_view::npos) ||
+            !CommandDecoder::tryParseInt(line.substr(0, delimiter), key)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+        BinaryProtocol::writeResult(
+                writer, Entry<int, std::string_view>(
+                                key, line.substr(delimiter + 1)));
+    }
+    return 0;
+}
+
+/**
+ * @brief Converts binary results to text results.
+ * @return `Constants::MAIN_ERROR` if the results end with a wrong input.
+ *         Else, `0`.
+ */
+int convertResultsToText(BufferedReader &reader, OutputWriter &writer) {
+    BinaryProtocol::readHeader(reader, BinaryProtocol::RESULTS_MAGIC);
+
+    char             tag = 0;
+    int              key = 0;
+    std::string_view value;
+    while (reader.readByte(tag)) {
+        if ((unsigned char) tag == BinaryProtocol::ERROR_TAG) {
+            writer.write(std::string_view(Constants::WRONG_INPUT));
+            writer.endLine();
+            return Constants::MAIN_ERROR;
+        }
+        if (((unsigned char) tag != BinaryProtocol::RESULT_TAG) ||
+            !BinaryProtocol::tryReadKeyAndValue(reader, key, value)) {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+
+        writer.write(key);
+        writer.write(' ');
+        writer.write(value);
+        writer.endLine();
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        std::cerr << "Usage: binaryConverter commands-to-binary | "
+                     "commands-to-text | results-to-binary | results-to-text"
+                  << std::endl;
+        return Constants::MAIN_ERROR;
+    }
+
+    BufferedReader reader(STDIN_FILENO);
+    OutputWriter   writer(STDOUT_FILENO);
+    try {
+        int result = 0;
+        if (std::strcmp(argv[1], "commands-to-binary") == 0) {
+            convertCommandsToBinary(reader, writer);
+        } else if (std::strcmp(argv[1], "commands-to-text") == 0) {
+            convertCommandsToText(reader, writer);
+        } else if (std::strcmp(argv[1], "results-to-binary") == 0) {
+            result = convertResultsToBinary(reader, writer);
+        } else if (std::strcmp(argv[1], "results-to-text") == 0) {
+            result = convertResultsToText(reader, writer);
+        } else {
+            throw std::runtime_error(Constants::WRONG_INPUT);
+        }
+        writer.flush();
+        return result;
+    } catch (std::exception &e) {
+        writer.flush();
+        std::cerr << Constants::WRONG_INPUT << std::endl;
+        return Constants::MAIN_ERROR;
+    }
+}
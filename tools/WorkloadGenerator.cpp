@@ -0,0 +1,121 @@
+#include "Constants.h"
+#include "OutputWriter.h"
+#include "tools/WorkloadGenerator.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @brief Generates a valid command stream of the program - to the standard
+ *        output - with the size, the mix of commands, and the distributions
+ *        of the keys and of the values given, by a seed.
+ *
+ * Usage:
+ * @code
+ * workloadGenerator [--commands N] [--seed S] [--mix a:1,b:1,c:1,d:1,f:4,g:1]
+ *                   [--keys uniform | zipf | sorted | reverse | sawtooth |
+ *                           duplicates | adversarial]
+ *                   [--key-range R] [--zipf-exponent X] [--period P]
+ *                   [--distinct-keys D]
+ *                   [--values fixed | uniform | geometric] [--value-length L]
+ *                   [--max-live M] > input.txt
+ * @endcode
+ * @li `--commands` the amount of commands, including the first `e`.
+ *     Defaults to `1000`. Parsed as a `double`, so `1e6` is fine.
+ * @li `--mix` the relative weight of each letter - a letter that is not
+ *     given weighs `0`. The `f` must weigh more than `0`.
+ * @li `--max-live` the maximum amount of entries at once. Defaults to `100`
+ *     - as the program holds up to `100` entries in each half of its
+ *     priority-queue.
+ *
+ * The same arguments always generate the same stream.
+ *
+ * @see WorkloadGenerator
+ */
+
+namespace {
+
+unsigned long parseNumber(const char *argument) {
+    return (unsigned long) std::stod(argument);
+}
+
+/// Parses a `--mix` such as `a:1,b:1,f:4`.
+void parseMix(const std::string &mix, unsigned long (&letterWeights)[7]) {
+    std::fill(std::begin(letterWeights), std::end(letterWeights), 0);
+    for (unsigned long start = 0; start < mix.length();) {
+        unsigned long end = mix.find(',', start);
+        if (end == std::string::npos) { end = mix.length(); }
+        std::string letterAndWeight = mix.substr(start, end - start);
+        if ((letterAndWeight.length() < 3) || (letterAndWeight[1] != ':') ||
+            (letterAndWeight[0] < CommandDecoder::MINIMUM_LETTER) ||
+            (letterAndWeight[0] > CommandDecoder::MAXIMUM_LETTER)) {
+            throw std::invalid_argument(mix);
+        }
+        letterWeights[letterAndWeight[0] - CommandDecoder::MINIMUM_LETTER] =
+                parseNumber(letterAndWeight.c_str() + 2);
+        start = end + 1;
+    }
+}
+
+WorkloadGenerator::Options parseOptions(int argc, char **argv) {
+    WorkloadGenerator::Options options;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) { throw std::invalid_argument(argv[i]); }
+        const char *value = argv[i + 1];
+        if (std::strcmp(argv[i], "--commands") == 0) {
+            options.commandCount = parseNumber(value);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            options.seed = std::stoul(value);
+        } else if (std::strcmp(argv[i], "--mix") == 0) {
+            parseMix(value, options.letterWeights);
+        } else if (std::strcmp(argv[i], "--keys") == 0) {
+            options.keyDistribution =
+                    WorkloadGenerator::getKeyDistribution(value);
+        } else if (std::strcmp(argv[i], "--key-range") == 0) {
+            options.keyRange = parseNumber(value);
+        } else if (std::strcmp(argv[i], "--zipf-exponent") == 0) {
+            options.zipfExponent = std::stod(value);
+        } else if (std::strcmp(argv[i], "--period") == 0) {
+            options.period = parseNumber(value);
+        } else if (std::strcmp(argv[i], "--distinct-keys") == 0) {
+            options.duplicateKeyCount = parseNumber(value);
+        } else if (std::strcmp(argv[i], "--values") == 0) {
+            options.valueLengthDistribution =
+                    WorkloadGenerator::getValueLengthDistribution(value);
+        } else if (std::strcmp(argv[i], "--value-length") == 0) {
+            options.valueLength = parseNumber(value);
+        } else if (std::strcmp(argv[i], "--max-live") == 0) {
+            options.maximumLiveCount = parseNumber(value);
+        } else {
+            throw std::invalid_argument(argv[i]);
+        }
+        i++;
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    OutputWriter writer(STDOUT_FILENO);
+    try {
+        WorkloadGenerator generator(parseOptions(argc, argv));
+        generator.generate(writer);
+        writer.flush();
+        return 0;
+    } catch (std::exception &e) {
+        std::cerr << "Usage: workloadGenerator [--commands N] [--seed S] "
+                     "[--mix a:1,b:1,c:1,d:1,f:4,g:1]\n"
+                     "    [--keys uniform | zipf | sorted | reverse | "
+                     "sawtooth | duplicates | adversarial]\n"
+                     "    [--key-range R] [--zipf-exponent X] [--period P] "
+                     "[--distinct-keys D]\n"
+                     "    [--values fixed | uniform | geometric] "
+                     "[--value-length L] [--max-live M]"
+                  << std::endl;
+        return Constants::MAIN_ERROR;
+    }
+}
@@ -0,0 +1,398 @@
+
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "CommandDecoder.h"
+#include "OutputWriter.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief This class generates a *valid* command stream of the program - the
+ *        number of commands, the `e` command, and then `f key value` and
+ *        `a`-`g` (but `e`) commands - by a *seed*, so that the same options
+ *        always generate the same stream, on any platform.
+ *
+ * The stream is valid by construction:
+ * @li The amount of *live* entries is tracked - so a query or a deletion is
+ *     never generated while there are no entries (an `f` is generated
+ *     instead), and an `f` is never generated while there are
+ *     `maximumLiveCount` entries (a deletion is generated instead).
+ * @li Each value is of at least a single char, out of `[a-zA-Z0-9]`.
+ *
+ * The keys are generated by one of the `KeyDistribution`s, and the lengths
+ * of the values by one of the `ValueLengthDistribution`s.
+ *
+ * For example:
+ * @code
+ * WorkloadGenerator::Options options;
+ * options.commandCount    = 1000;
+ * options.keyDistribution = WorkloadGenerator::KeyDistribution::ZIPF;
+ * OutputWriter writer(STDOUT_FILENO);
+ * WorkloadGenerator(options).generate(writer);
+ * @endcode
+ *
+ * @see CommandDecoder
+ * @version 1.1
+ */
+class WorkloadGenerator {
+
+  public:
+    /// How the keys of the `f` commands are generated.
+    enum class KeyDistribution {
+
+        /// Uniformly within `[-keyRange, keyRange]`.
+        UNIFORM,
+
+        /// By a *Zipf* distribution of the `zipfExponent` - `0` the most
+        /// frequent, then `1`, and so on - within `[0, keyRange]`.
+        ZIPF,
+
+        /// Ascending from `-keyRange` - wrapping around after `keyRange`.
+        SORTED,
+
+        /// Descending from `keyRange` - wrapping around after `-keyRange`.
+        REVERSE_SORTED,
+
+        /// Ascending runs of `period` keys each, within `[0, keyRange]`.
+        SAWTOOTH,
+
+        /// Uniformly out of only `duplicateKeyCount` distinct keys.
+        HEAVY_DUPLICATES,
+
+        /// Each key is on the side of the median that moves an entry between
+        /// the two halves of the `PriorityQueueKv` - an ever lower key while
+        /// the amount of live entries is odd, and an ever higher key while it
+        /// is even.
+        ADVERSARIAL_TO_MEDIAN
+    };
+
+  public:
+    /// How the lengths of the values of the `f` commands are generated.
+    enum class ValueLengthDistribution {
+
+        /// Always `valueLength`.
+        FIXED,
+
+        /// Uniformly within `[1, valueLength]`.
+        UNIFORM,
+
+        /// *Geometrically*, with a mean of `valueLength` - mostly short
+        /// values, with a long tail.
+        GEOMETRIC
+    };
+
+  public:
+    /// The options of the stream generated.
+    struct Options {
+
+        /// The amount of commands - including the first `e` command.
+        unsigned long commandCount = 1000;
+
+        unsigned long seed = 1;
+
+        /**
+         * The *relative* weight of each of the letters `a` to `g`. The
+         * weight of the `e` is ignored - there is only the first `e`.
+         */
+        unsigned long letterWeights[7] = {1, 1, 1, 1, 0, 4, 1};
+
+        KeyDistribution keyDistribution = KeyDistribution::UNIFORM;
+
+        /// The keys are within `[-keyRange, keyRange]` (or `[0, keyRange]`).
+        unsigned long keyRange = 1000000;
+
+        double zipfExponent = 1.1;
+
+        /// The length of each ascending run of `KeyDistribution::SAWTOOTH`.
+        unsigned long period = 1000;
+
+        unsigned long duplicateKeyCount = 16;
+
+        ValueLengthDistribution valueLengthDistribution =
+                ValueLengthDistribution::FIXED;
+
+        unsigned long valueLength = 8;
+
+        /**
+         * The maximum amount of live entries. The program holds up to `100`
+         * entries in each half of its `PriorityQueueKv`.
+         */
+        unsigned long maximumLiveCount = 100;
+    };
+
+  protected:
+    static constexpr char *OPTIONS_MESSAGE =
+            (char *) "WorkloadGenerator: invalid options.";
+
+  protected:
+    /// The maximum amount of distinct keys of `KeyDistribution::ZIPF`.
+    static constexpr unsigned long MAXIMUM_ZIPF_KEY_COUNT = 1UL << 20;
+
+  protected:
+    static constexpr char *VALUE_CHARS = (char *) "abcdefghijklmnopqrstuvwxyz"
+                                                  "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                                  "0123456789";
+
+  protected:
+    Options _options;
+
+  protected:
+    /// The state of the *SplitMix64* random generator.
+    std::uint64_t _state = 0;
+
+  protected:
+    /// The *cumulative* weights of the letters `a` to `g`.
+    unsigned long _cumulativeWeights[7] = {};
+
+  protected:
+    /// The *cumulative* probabilities of the keys of `KeyDistribution::ZIPF`.
+    std::vector<double> _zipfCumulative;
+
+  protected:
+    /// The amount of `f` commands generated so far.
+    unsigned long _insertCount = 0;
+
+  protected:
+    unsigned long _liveCount = 0;
+
+  protected:
+    /// The next low key of `KeyDistribution::ADVERSARIAL_TO_MEDIAN`.
+    long _lowKey = -1;
+
+  protected:
+    /// The next high key of `KeyDistribution::ADVERSARIAL_TO_MEDIAN`.
+    long _highKey = 1;
+
+  protected:
+    std::string _value;
+
+  public:
+    /// @throws std::invalid_argument in case the @p options are invalid.
+    explicit WorkloadGenerator(const Options &options)
+        : _options(options), _state(options.seed) {
+        unsigned long total = 0;
+        for (unsigned long i = 0; i < 7; i++) {
+            if (i != CommandDecoder::FIRST_LETTER - 'a') {
+                total += options.letterWeights[i];
+            }
+            _cumulativeWeights[i] = total;
+        }
+        unsigned long insertWeight = options.letterWeights
+                [CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER - 'a'];
+        if ((options.commandCount < 1) || (total == 0) ||
+            (insertWeight == 0) ||
+            (options.keyRange > (unsigned long) INT_MAX) ||
+            (options.period < 1) || (options.duplicateKeyCount < 1) ||
+            (options.valueLength < 1) || (options.maximumLiveCount < 1)) {
+            throw std::invalid_argument(OPTIONS_MESSAGE);
+        }
+
+        if (options.keyDistribution == KeyDistribution::ZIPF) {
+            initZipf();
+        }
+    }
+
+  public:
+    /// @brief Writes the whole stream to the given @p writer.
+    void generate(OutputWriter &writer) {
+        writer.write(_options.commandCount);
+        writer.endLine();
+        writer.write(CommandDecoder::FIRST_LETTER);
+        writer.endLine();
+        for (unsigned long i = 1; i < _options.commandCount; i++) {
+            writeCommand(writer);
+        }
+    }
+
+  public:
+    /**
+     * @brief Sets the given @p command to the next command of the stream -
+     *        after the first `e` command.
+     *
+     * @note the `value` of the @p command is valid only until the next call.
+     */
+    void nextCommand(CommandDecoder::Command &command) {
+        char letter = nextLetter();
+        if ((letter != CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) &&
+            (_liveCount == 0)) {
+            letter = CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER;
+        } else if ((letter == CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) &&
+                   (_liveCount >= _options.maximumLiveCount)) {
+            letter = (nextBelow(2) == 0) ? 'b' : 'd';
+        }
+
+        command.opcode = letter;
+        if (letter == CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) {
+            command.key   = nextKey();
+            command.value = nextValue();
+            _insertCount++;
+            _liveCount++;
+        } else if ((letter == 'b') || (letter == 'd')) {
+            _liveCount--;
+        }
+    }
+
+  public:
+    /**
+     * @return the `KeyDistribution` of the given @p name - `uniform`,
+     *         `zipf`, `sorted`, `reverse`, `sawtooth`, `duplicates` or
+     *         `adversarial`.
+     * @throws std::invalid_argument in case of any other @p name.
+     */
+    static KeyDistribution getKeyDistribution(const std::string &name) {
+        if (name == "uniform") { return KeyDistribution::UNIFORM; }
+        if (name == "zipf") { return KeyDistribution::ZIPF; }
+        if (name == "sorted") { return KeyDistribution::SORTED; }
+        if (name == "reverse") { return KeyDistribution::REVERSE_SORTED; }
+        if (name == "sawtooth") { return KeyDistribution::SAWTOOTH; }
+        if (name == "duplicates") { return KeyDistribution::HEAVY_DUPLICATES; }
+        if (name == "adversarial") {
+            return KeyDistribution::ADVERSARIAL_TO_MEDIAN;
+        }
+        throw std::invalid_argument(name);
+    }
+
+  public:
+    /**
+     * @return the `ValueLengthDistribution` of the given @p name - `fixed`,
+     *         `uniform` or `geometric`.
+     * @throws std::invalid_argument in case of any other @p name.
+     */
+    static ValueLengthDistribution
+    getValueLengthDistribution(const std::string &name) {
+        if (name == "fixed") { return ValueLengthDistribution::FIXED; }
+        if (name == "uniform") { return ValueLengthDistribution::UNIFORM; }
+        if (name == "geometric") { return ValueLengthDistribution::GEOMETRIC; }
+        throw std::invalid_argument(name);
+    }
+
+  protected:
+    void writeCommand(OutputWriter &writer) {
+        CommandDecoder::Command command;
+        nextCommand(command);
+        writer.write(command.opcode);
+        if (command.opcode == CommandDecoder::ALLOWED_TWO_PARAMETERS_LETTER) {
+            writer.write(CommandDecoder::DELIMITER);
+            writer.write(command.key);
+            writer.write(CommandDecoder::DELIMITER);
+            writer.write(command.value);
+        }
+        writer.endLine();
+    }
+
+  protected:
+    char nextLetter() {
+        unsigned long weight = nextBelow(_cumulativeWeights[6]);
+        unsigned long i      = 0;
+        while (weight >= _cumulativeWeights[i]) { i++; }
+        return (char) ('a' + i);
+    }
+
+  protected:
+    int nextKey() {
+        auto          range = (long) _options.keyRange;
+        unsigned long i     = _insertCount;
+        switch (_options.keyDistribution) {
+            case KeyDistribution::UNIFORM:
+                return (int) ((long) nextBelow(2 * range + 1) - range);
+            case KeyDistribution::ZIPF:
+                return (int) (std::upper_bound(_zipfCumulative.begin(),
+                                               _zipfCumulative.end(),
+                                               nextDouble()) -
+                              _zipfCumulative.begin());
+            case KeyDistribution::SORTED:
+                return (int) ((long) (i % (2 * range + 1)) - range);
+            case KeyDistribution::REVERSE_SORTED:
+                return (int) (range - (long) (i % (2 * range + 1)));
+            case KeyDistribution::SAWTOOTH:
+                return (int) ((i % _options.period) * (range + 1) /
+                              _options.period);
+            case KeyDistribution::HEAVY_DUPLICATES:
+                return (int) (nextBelow(_options.duplicateKeyCount) *
+                              (range + 1) / _options.duplicateKeyCount);
+            case KeyDistribution::ADVERSARIAL_TO_MEDIAN:
+                return nextAdversarialKey();
+        }
+        return 0;
+    }
+
+  protected:
+    /**
+     * @return a key that is lower than all the keys before it while the
+     *         amount of live entries is odd, and higher than all of them while
+     *         it is even - wrapping around at the `keyRange`.
+     */
+    int nextAdversarialKey() {
+        auto range = (long) _options.keyRange;
+        if (_liveCount % 2 == 1) {
+            if (_lowKey < -range) { _lowKey = -1; }
+            return (int) _lowKey--;
+        }
+        if (_highKey > range) { _highKey = 1; }
+        return (int) _highKey++;
+    }
+
+  protected:
+    std::string_view nextValue() {
+        unsigned long length = _options.valueLength;
+        switch (_options.valueLengthDistribution) {
+            case ValueLengthDistribution::FIXED:
+                break;
+            case ValueLengthDistribution::UNIFORM:
+                length = 1 + nextBelow(_options.valueLength);
+                break;
+            case ValueLengthDistribution::GEOMETRIC:
+                length = 1 + (unsigned long) (std::log(1 - nextDouble()) /
+                                              std::log(1 - 1.0 / length));
+                break;
+        }
+
+        _value.resize(length);
+        for (char &c : _value) {
+            c = VALUE_CHARS[nextBelow(std::strlen(VALUE_CHARS))];
+        }
+        return _value;
+    }
+
+  protected:
+    void initZipf() {
+        unsigned long count =
+                std::min(_options.keyRange + 1, MAXIMUM_ZIPF_KEY_COUNT);
+        _zipfCumulative.resize(count);
+        double total = 0;
+        for (unsigned long i = 0; i < count; i++) {
+            total += 1 / std::pow((double) (i + 1), _options.zipfExponent);
+            _zipfCumulative[i] = total;
+        }
+        for (double &cumulative : _zipfCumulative) { cumulative /= total; }
+    }
+
+  protected:
+    /// @return the next random number of the *SplitMix64* generator.
+    std::uint64_t next() {
+        std::uint64_t z = (_state += 0x9E3779B97F4A7C15ULL);
+        z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z               = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+  protected:
+    /// @return a random number within `[0, bound)`.
+    unsigned long nextBelow(unsigned long bound) {
+        return (unsigned long) (((unsigned __int128) next() * bound) >> 64);
+    }
+
+  protected:
+    /// @return a random number within `[0, 1)`.
+    double nextDouble() { return (double) (next() >> 11) * 0x1.0p-53; }
+};
+
+#endif // WORKLOAD_GENERATOR_H